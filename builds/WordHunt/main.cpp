@@ -6,11 +6,11 @@
 // This is because we need ImTextureID to carry a 64-bit value and by default ImTextureID is defined as void*.
 // This define is set in the example .vcxproj file and need to be replicated in your app or by adding it to your imconfig.h file.
 
-#include <iostream>
 
 #define IMGUI_DEFINE_MATH_OPERATORS
 
 #include "imgui/imgui.h"
+#include "imgui/imgui_internal.h"
 #include "imgui_impl_win32.h"
 #include "imgui_impl_dx12.h"
 #include <d3d12.h>
@@ -19,9 +19,11 @@
 #include "wordhunt.h"
 #include "wordhunt_styles.h"
 #include "macros.h"
+#include <atomic>
 #include <chrono>
 #include <random>
 #include <set>
+#include <thread>
 
 #ifdef _DEBUG
 #define DX12_ENABLE_DEBUG_LAYER
@@ -64,11 +66,12 @@ void CreateRenderTarget();
 void CleanupRenderTarget();
 void WaitForLastSubmittedFrame();
 FrameContext* WaitForNextFrameResources();
+void WaitForInputOrTimeout(double timeout_seconds);
 LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 // Forward declarations of drawing functions
 //bool SolutionItem(Solution* entry, const ImVec2& size, ImU32 solution_color, ImGuiWindowFlags flags = 0, const std::string prefix = "");
-bool DrawSelectionPath(const ImVec2* tile_path_pos, const int word_length, ImU32 line_color, const float line_thickness);
+bool DrawSelectionPath(ImDrawList* draw_list, const ImVec2* tile_path_pos, const int word_length, ImU32 line_color, const float line_thickness);
 
 // Forward declarations of static WordHunt variables
 
@@ -145,6 +148,10 @@ int main(int, char**)
     // WordHunt setup
     WordHunt::Setup("../../misc/files/dictionary.txt");
     Dictionary* current_dictionary = WordHunt::GetDefaultDictionary();
+    static PuzzleLibrary puzzle_library; // Pre-solved boards, see builds/WordHuntTools/wordhunt_library.cpp
+    puzzle_library.Open("../../misc/files/puzzles.whl");
+    static SessionArena session_arena; // Solver, solutions and paths of the running game, released when the next one starts
+    WordHunt::SetSessionArena(&session_arena);
 
     // Our state
     bool        show_demo_window = false;
@@ -167,24 +174,31 @@ int main(int, char**)
     static int          num_columns = default_num_columns;
     static char         board[max_row][max_columns];
     static bool         active_tiles[max_row][max_columns];
-    static char         letters[256] = "";
+    static char         letters[num_tiles * WORDHUNT_TILE_STRIDE + 1] = "";
+    static BoardGraph   board_graph; // Which tiles a selection may move between
 
     // Selection Variables
     static ImVec2       tile_centers[max_row][max_columns]; // Entries are center coordinates (center.x, center.y) of a tile
     static ImVec2       tile_path_pos[num_tiles]; // Center positions of currently selected tiles
     static ImVec2       tile_path_id[num_tiles]; // Holds the (Row, Column) of the tiles selected
+    static int          path_length = 0; // Tiles in path, a multi-letter tile adds several letters to word
     static bool         activated[max_row][max_columns]; // Is activated in path
 
     // Solution
-    static char         word[num_tiles];
+    static char         word[num_tiles * WORDHUNT_MAX_TILE_LEN + 1];
     static int          word_length = 0;
-    static std::string  word_str;
-    static char         previous_word[256];
+    static TrieCursor   word_cursor; // Dictionary nodes the path has reached, a tile is pushed or popped as the drag moves
+    static bool         word_changed = true; // Path changed since currently_is_word / currently_found were updated
+    static char         previous_word[num_tiles * WORDHUNT_MAX_TILE_LEN + 1];
     static int          previous_word_length = 0;
-    static std::string  previous_word_str;
     static bool         currently_is_word = false;
-    static std::set<std::string> found_words;
-    static std::set<Solution*, SolutionPointerComparator> discovered;
+    static bool         currently_found = false;
+    static ImBitVector  found_ids; // Bit per word ID of the solver, the board is solved before play starts
+    static ImVector<SolutionItemCache> found_items; // Rows of the found words panel by word ID, holding the path the player traced
+    static ImVector<SolutionItemCache> solution_items; // Rows of the possible words panel by word ID
+    static ImVector<int> found_list; // IDs of the found words in ascending order, the rows of the found words panel
+    static int          found_count = 0;
+    static int          found_points = 0;
 
     // Line Variables
     // White lines, green background on real word
@@ -204,17 +218,40 @@ int main(int, char**)
 
     std::mt19937        rng((unsigned int)__rdtsc()); // random function
     static int          game_phase = WordHuntGamePhase_Selection;
-    static Seed*        game_seed;
-    static char         seed_string[256] = "";
+    static Seed         game_seed_storage(0u);
+    static Seed*        game_seed = &game_seed_storage;
+    static char         seed_string[WORDHUNT_SEED_TEXT_MAX] = "";
+    static bool         filter_board = false; // Only random games are filtered, a loaded seed plays as given
+    static const PuzzleRecord* library_board = NULL; // Set when the board comes from the puzzle library
+    static BoardConstraints board_constraints;
+    board_constraints.min_points = 30000;
+    board_constraints.required_length = 6;
 
     static Solver* solver;
+    static std::thread solve_thread; // Solves the board of WordHuntGamePhase_Solve, joined once solve_done is set
+    static std::atomic<bool> solve_done(false);
 
     WHStyle* styler = WHGui::GetWHStyle();
 
+    // Idle rendering
+    // With nothing moving the loop sleeps until a message arrives or idle_timeout runs out, e.g. the clock's next
+    // visible step. A few frames are drawn after every message and phase change so hovering and layout settle.
+    // Work finishing on another thread wakes the loop by posting a message to the window.
+    bool                idle_rendering = true; // false draws every frame at the vsync rate
+    const int           idle_settle_frames = 3;
+    int                 frames_to_draw = idle_settle_frames;
+    float               idle_timeout = FLT_MAX; // Seconds until something on screen changes by itself, FLT_MAX when nothing does
+    int                 drawn_phase = game_phase;
+
     // Main loop
     bool done = false;
     while (!done)
     {
+        if (idle_rendering && frames_to_draw <= 0)
+        {
+            WaitForInputOrTimeout(idle_timeout);
+        }
+
         // Poll and handle messages (inputs, window resize, etc.)
         // See the WndProc() function below for our to dispatch events to the Win32 backend.
         MSG msg;
@@ -224,9 +261,20 @@ int main(int, char**)
             ::DispatchMessage(&msg);
             if (msg.message == WM_QUIT)
                 done = true;
+            frames_to_draw = idle_settle_frames;
         }
         if (done)
             break;
+        frames_to_draw--;
+        idle_timeout = FLT_MAX;
+
+        // Fonts first asked for last frame go into the atlas, in-flight frames still sample the old font texture
+        if (WHGui::HasPendingFonts())
+        {
+            WaitForLastSubmittedFrame();
+            ImGui_ImplDX12_InvalidateDeviceObjects();
+            WHGui::UpdateFonts();
+        }
 
         // Start the Dear ImGui frame
         ImGui_ImplDX12_NewFrame();
@@ -314,12 +362,14 @@ int main(int, char**)
 
                     if (ImGui::Button(seed_button_text.data()))
                     {
-                        if (WordHunt::IsValidSeed(seed_buffer) == -1)
+                        if (WordHunt::ParseSeed(seed_buffer, NULL) == -1)
                         {
                             seed_button_text = "Invalid seed";
                         }
                         else {
-                            game_seed = new Seed(seed_buffer);
+                            *game_seed = Seed(seed_buffer);
+                            filter_board = false;
+                            library_board = NULL;
                             seed_button_text = "Seed loaded!";
                             game_phase = WordHuntGamePhase_Generate;
                         }
@@ -327,8 +377,32 @@ int main(int, char**)
 
                     if (ImGui::Button("Begin Random Game"))
                     {
+                        *game_seed = Seed((unsigned int)rng());
+                        filter_board = true;
+                        library_board = NULL;
                         game_phase = WordHuntGamePhase_Generate;
                     }
+
+                    if (puzzle_library.IsOpen() && puzzle_library.header->tile_count <= (unsigned int)num_tiles)
+                    {
+                        const bool daily = ImGui::Button("Daily Board");
+                        ImGui::SameLine();
+                        const bool hard = ImGui::Button("Hard Board");
+                        if (daily || hard)
+                        {
+                            const unsigned int day = (unsigned int)(std::chrono::duration_cast<std::chrono::hours>(std::chrono::system_clock::now().time_since_epoch()).count() / 24);
+                            const int hard_count = puzzle_library.Count(PuzzleDifficulty_Hard);
+                            library_board = daily ? puzzle_library.Daily(PuzzleDifficulty_Medium, day)
+                                                  : (hard_count ? puzzle_library.Get(PuzzleDifficulty_Hard, std::uniform_int_distribution<int>(0, hard_count - 1)(rng)) : NULL);
+                        }
+                        if (library_board)
+                        {
+                            *game_seed = Seed(puzzle_library.header->seed);
+                            game_seed->seed_value = library_board->seed_value;
+                            filter_board = false;
+                            game_phase = WordHuntGamePhase_Generate;
+                        }
+                    }
                     if (game_phase != WordHuntGamePhase_Selection)
                     {
                         strcpy_s(seed_buffer, "Enter a seed or ignore and continue.");
@@ -337,29 +411,77 @@ int main(int, char**)
 
                 if (game_phase == WordHuntGamePhase_Generate)
                 {
-                    found_words.clear();
-                    discovered.clear();
-                    char* temp = game_seed->to_string();
-                    int index = 0;
-                    while (temp[index] != 0)
-                    {
-                        std::cout << temp[index]; // temp magically changes because of compiler optimization deadass deleted the second half of my string
-                        seed_string[index] = temp[index];
-                        index++;
-                    }
+                    // Everything the last game allocated goes at once, the solver and the list rows are refilled below
+                    session_arena.Reset();
+                    word_cursor.Reset(current_dictionary);
+                    word_changed = true;
+                    // The board shape comes from the seed so the solver and the selection graph agree with what is drawn
+                    num_rows = game_seed->rows;
+                    num_columns = game_seed->cols;
                     for (int i = 0; i < num_rows; i++)
                     {
                         for (int j = 0; j < num_columns; j++)
                         {
-                            active_tiles[i][j] = true;
+                            active_tiles[i][j] = game_seed->IsActive(i, j);
                         }
                     }
 
-                    WordHunt::GenerateGame(letters, num_tiles, game_seed->seed_value);
+                    if (library_board)
+                    {
+                        // Already generated and solved offline, the tiles are copied out of the mapped file
+                        memset(letters, 0, sizeof(letters));
+                        memcpy(letters, library_board->Letters(), puzzle_library.header->tile_count * WORDHUNT_TILE_STRIDE);
+                        library_board = NULL;
+                    }
+                    else if (filter_board)
+                    {
+                        WordHunt::GenerateGame(letters, num_tiles, game_seed, board_constraints);
+                    }
+                    else
+                    {
+                        WordHunt::GenerateGame(letters, num_tiles, game_seed);
+                    }
+
+                    // Filtering may have moved the seed value, so the string is taken from the board that is played
+                    game_seed->to_string(seed_string, sizeof(seed_string));
                     WordHunt::SetCurrentSeed(game_seed);
-                    game_phase = WordHuntGamePhase_Play;
-                    start_timer = std::chrono::high_resolution_clock::now();
-                    end_timer = start_timer + std::chrono::seconds(int(game_length_seconds));
+                    WordHunt::BuildBoardGraph(&board_graph, game_seed);
+
+                    // Free boards with blanks take a few hundred ms to solve, so the solve runs off the frame. Until it
+                    // is joined the worker owns the session arena and the current seed.
+                    solve_done = false;
+                    solve_thread = std::thread([hwnd]()
+                    {
+                        solver = WordHunt::SolveCurrentSeed(letters);
+                        solve_done = true;
+                        ::PostMessage(hwnd, WM_NULL, 0, 0);
+                    });
+                    game_phase = WordHuntGamePhase_Solve;
+                }
+
+                if (game_phase == WordHuntGamePhase_Solve)
+                {
+                    if (!solve_done)
+                    {
+                        CENTERED_CONTROL(ImGui::Text("Solving the board..."));
+                    }
+                    else
+                    {
+                        solve_thread.join();
+                        found_ids.Create((int)solver->words.size());
+                        found_items.resize((int)solver->words.size());
+                        solution_items.resize((int)solver->words.size());
+                        for (int id = 0; id < solution_items.Size; id++)
+                        {
+                            WHGui::BuildSolutionItem(&solution_items[id], solver->words[id], "solution");
+                        }
+                        found_list.resize(0);
+                        found_count = 0;
+                        found_points = 0;
+                        game_phase = WordHuntGamePhase_Play;
+                        start_timer = std::chrono::high_resolution_clock::now();
+                        end_timer = start_timer + std::chrono::seconds(int(game_length_seconds));
+                    }
                 }
 
                 if (game_phase == WordHuntGamePhase_Play || game_phase == WordHuntGamePhase_Result)
@@ -384,13 +506,37 @@ int main(int, char**)
                         auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start_timer);
                         float passed_percentage = float(delta.count() / (game_length_seconds * 1000.0f));
 
+                        // The passed time pie grows by a pixel along the rim every clock_step_seconds, nothing to draw before that
+                        const float clock_step_seconds = game_length_seconds / (2.0f * IM_PI * clock_inner_radius);
+                        const float passed_seconds = delta.count() / 1000.0f;
+                        idle_timeout = ImMin(idle_timeout, clock_step_seconds - ImFmod(passed_seconds, clock_step_seconds));
+                        idle_timeout = ImMin(idle_timeout, ImMax(game_length_seconds - passed_seconds, 0.0f));
+
                         ImVec2 clock_position = ImVec2((ImGui::GetWindowWidth() - clock_width) * 0.5f, ImGui::GetCursorPosY());
                         ImGui::SetCursorPos(clock_position);
                         ImVec2 clock_absolute_center = ImGui::GetCursorScreenPos() + ImVec2(clock_width * 0.5f, clock_height * 0.5f);
                         if (ImGui::BeginChild("Clock", ImVec2(clock_width, clock_height), false, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs))
                         {
-                            ImGui::GetForegroundDrawList()->AddCircleFilled(clock_absolute_center, clock_outer_radius, clock_rim_color);
-                            ImGui::GetForegroundDrawList()->AddCircleFilled(clock_absolute_center, clock_inner_radius, clock_center_color);
+                            // The face and ticks are recorded around the center once, only the passed time pie is tessellated each frame
+                            static RecordedDrawList clock_face;
+                            static RecordedDrawList clock_ticks;
+                            if (clock_face.Record(0))
+                            {
+                                clock_face.draw_list->AddCircleFilled(ImVec2(0.0f, 0.0f), clock_outer_radius, clock_rim_color);
+                                clock_face.draw_list->AddCircleFilled(ImVec2(0.0f, 0.0f), clock_inner_radius, clock_center_color);
+                            }
+                            if (clock_ticks.Record(0))
+                            {
+                                for (int i = 0; i < clock_tick_quantity; i++)
+                                {
+                                    ImVec2 angle = ImVec2(cosf(i * clock_angle_step), sinf(i * clock_angle_step));
+                                    ImVec2 p1 = ImVec2(clock_inner_radius, clock_inner_radius) * angle;
+                                    ImVec2 p2 = p1 - ImVec2(clock_tick_length, clock_tick_length) * angle;
+                                    clock_ticks.draw_list->AddLine(p1, p2, clock_tick_color);
+                                }
+                            }
+
+                            clock_face.Draw(ImGui::GetForegroundDrawList(), clock_absolute_center);
                             if (passed_percentage < 1.0f)
                             {
                                 ImGui::GetForegroundDrawList()->_Path.push_back(clock_absolute_center);
@@ -401,19 +547,16 @@ int main(int, char**)
                             {
                                 game_phase = WordHuntGamePhase_Result;
                                 word_length = 0;
+                                path_length = 0;
+                                word_cursor.Clear();
+                                word_changed = true;
                                 memset(activated, 0, sizeof(activated));
                                 ImGui::GetForegroundDrawList()->_ResetForNewFrame();
+                                ImGui::GetForegroundDrawList()->PushTextureID(io.Fonts->TexID);
+                                ImGui::GetForegroundDrawList()->PushClipRectFullScreen();
                                 ImGui::GetForegroundDrawList()->AddCircleFilled(clock_absolute_center, clock_inner_radius, clock_passed_color);
-                                solver = WordHunt::SolveCurrentSeed(letters);
-                            }
-
-                            for (int i = 0; i < clock_tick_quantity; i++)
-                            {
-                                ImVec2 angle = ImVec2(cosf(i * clock_angle_step), sinf(i * clock_angle_step));
-                                ImVec2 p1 = ImVec2(clock_inner_radius, clock_inner_radius) * angle + clock_absolute_center;
-                                ImVec2 p2 = p1 - ImVec2(clock_tick_length, clock_tick_length) * angle;
-                                ImGui::GetForegroundDrawList()->AddLine(p1, p2, clock_tick_color);
                             }
+                            clock_ticks.Draw(ImGui::GetForegroundDrawList(), clock_absolute_center);
                         }
                         ImGui::EndChild();
                     }
@@ -423,11 +566,24 @@ int main(int, char**)
                     const ImVec2        tile_size = ImVec2(100, 100);
 
                     static ImVec2       previous_tile = ImVec2(-1, -1);
-                    ImVec2 board_size = ImVec2(tile_size.x, tile_size.y) * ImVec2(float(num_columns), float(num_rows)) + style.ItemSpacing * ImVec2(float(num_columns - 1), float(num_rows - 1));
+                    BoardWidgetLayout board_layout;
+                    board_layout.tile_size = tile_size;
+                    board_layout.spacing = style.ItemSpacing;
+                    board_layout.hit_padding = TilePadding;
+                    board_layout.rows = num_rows;
+                    board_layout.cols = num_columns;
+                    board_layout.hex = game_seed->layout == BoardLayout_Hex;
+                    ImVec2 board_size = board_layout.Size();
 
                     // Set correct color theme
-                    currently_is_word = current_dictionary->IsWord(word, word_length);
-                    if (currently_is_word && word_length > 2)
+                    if (word_changed)
+                    {
+                        const int word_id = word_length >= WordHunt::GetMinWordLength() ? solver->WordId(word_cursor.WordNode()) : -1;
+                        currently_is_word = word_id >= 0;
+                        currently_found = currently_is_word && found_ids.TestBit(word_id);
+                        word_changed = false;
+                    }
+                    if (currently_is_word)
                     {
                         line_color = pale_white;
                     }
@@ -436,113 +592,94 @@ int main(int, char**)
                         line_color = pale_red;
                     }
 
-                    // Draw selection path
-
-                    DrawSelectionPath(tile_path_pos, word_length, line_color, line_thickness);
-
                     // Create a style for the Tiles
                     // Rounded square tiles, black serif font
                     ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, 15.0f);
                     ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(0, 0, 0, 255));
-                    ImGui::PushFont(io.Fonts->Fonts[NotoSerifSemiBold * 10 + FontSize_80px]);
+                    ImGui::PushFont(WHGui::FontRetrieve(NotoSerifSemiBold, FontSize_80px, styler->TileTextGlyphs));
 
                     // Center the board
                     ImVec2 board_pos = ImVec2((ImGui::GetWindowWidth() - board_size.x) * 0.5f, ImGui::GetCursorPosY());
                     ImGui::SetCursorPos(board_pos);
-                    if (ImGui::BeginChild("Board", board_size, false, ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollbar))
+                    board_layout.origin = ImGui::GetCursorScreenPos();
+                    static ImU32 tile_colors[num_tiles];
+                    for (int row = 0; row < num_rows; row++)
                     {
-                        for (int row = 0; row < num_rows; row++)
+                        for (int column = 0; column < num_columns; column++)
                         {
-                            for (int column = 0; column < num_columns; column++)
+                            tile_centers[row][column] = board_layout.TileCenter(row, column);
+                            ImU32 tile_color = default_board_color;
+                            if (activated[row][column])
                             {
-                                if (column) ImGui::SameLine();
-
-                                // Creating a unique tile ID for each
-                                char TileID[7] = "Tile  ";
-                                TileID[4] = char(row + 1);
-                                TileID[5] = char(column + 1);
-
-                                ImU32 tile_color = default_board_color;
-                                if (activated[row][column])
+                                // TODO - Find a suitable way to make the after-game hover work
+                                if (game_phase == WordHuntGamePhase_Result)
                                 {
-                                    // TODO - Find a suitable way to make the after-game hover work
-                                    if (game_phase == WordHuntGamePhase_Result)
-                                    {
-                                        tile_color = pale_green;
-                                    }
-                                    else if (word_length > 2 && currently_is_word)
-                                    {
-                                        word_str = std::string(word, word + word_length);
-                                        if (found_words.find(word_str) == found_words.end())
-                                        {
-                                            tile_color = pale_green;
-                                        }
-                                        else
-                                        {
-                                            tile_color = bright_yellow;
-                                        }
-                                    }
-                                    else
-                                    {
-                                        tile_color = pale_white;
-                                    }
+                                    tile_color = pale_green;
                                 }
-
-                                ImGui::PushStyleColor(ImGuiCol_ChildBg, tile_color);
-                                // Tile Creation
-                                ImGuiWindowFlags tile_flag = ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoMove;
-                                if (!active_tiles[row][column])
+                                else if (currently_is_word)
                                 {
-                                    tile_flag |= ImGuiWindowFlags_NoBackground;
+                                    tile_color = currently_found ? bright_yellow : pale_green;
                                 }
-                                if (ImGui::BeginChild(TileID, tile_size, true, tile_flag))
+                                else
                                 {
-                                    tile_centers[row][column] = ImGui::GetWindowPos() + tile_size / 2.0f;
-
-                                    // Center and print tile
-                                    char* visible_character = &letters[(row * num_rows + column) * 2];
-                                    ImVec2 text_dimensions = ImGui::CalcTextSize(visible_character);
-                                    ImGui::SetCursorPos((tile_size - text_dimensions) * 0.5f);
-                                    ImGui::Text(visible_character);
-
-                                    // Check if hovering over a tile
-                                    if (game_phase == WordHuntGamePhase_Play)
-                                    {
-                                        ImGui::SetCursorPos(ImVec2());
-                                        ImVec2 hitbox_min = ImGui::GetCursorScreenPos() + ImVec2(TilePadding, TilePadding);
-                                        ImVec2 hitbox_max = hitbox_min + tile_size;
-                                        if (ImGui::IsMouseHoveringRect(hitbox_min, hitbox_max) && ImGui::IsMouseDown(ImGuiMouseButton_Left))
-                                        {
-                                            if (!activated[row][column] && ((previous_tile.x == -1 && previous_tile.y == -1) || (abs(previous_tile.x - row) <= 1 && abs(previous_tile.y - column) <= 1)))
-                                            {
-                                                activated[row][column] = 1;
-                                                char letter = visible_character[0];
-                                                word[word_length] = letter;
-                                                tile_path_id[word_length] = ImVec2(float(row), float(column));
-                                                tile_path_pos[word_length++] = tile_centers[row][column];
-                                                word[word_length] = 0;
-                                                previous_tile = ImVec2(float(row), float(column));
-                                            }
-                                            if (word_length)
-                                            {
-                                                ImGui::GetForegroundDrawList()->AddLine(tile_path_pos[word_length - 1], io.MousePos, line_color, line_thickness);
-                                                ImGui::GetForegroundDrawList()->AddCircleFilled(io.MousePos, line_thickness / 2, line_color);
-                                            }
-                                        }
-                                    }
+                                    tile_color = pale_white;
                                 }
-                                ImGui::EndChild();
-
-                                ImGui::PopStyleColor();
                             }
+                            tile_colors[row * num_columns + column] = tile_color;
                         }
                     }
-                    ImGui::EndChild();
+                    static int crossed_tiles[num_tiles];
+                    static RecordedDrawList board_tiles;
+                    const int crossed_count = WHGui::Board("Board", board_layout, game_seed, letters, tile_colors, &board_tiles, crossed_tiles, num_tiles);
 
                     ImGui::PopFont();
                     ImGui::PopStyleColor();
                     ImGui::PopStyleVar();
 
+                    // Apply every tile dragged over since the last frame, in the order they were crossed
+                    for (int crossed_n = 0; game_phase == WordHuntGamePhase_Play && crossed_n < crossed_count; crossed_n++)
+                    {
+                        const int hovered_tile = crossed_tiles[crossed_n];
+                        const int row = hovered_tile / num_columns;
+                        const int column = hovered_tile % num_columns;
+                        const char* visible_character = WordHunt::GetTile(letters, hovered_tile);
+                        const int previous_index = int(previous_tile.x) * num_columns + int(previous_tile.y);
+                        if (!activated[row][column] && ((previous_tile.x == -1 && previous_tile.y == -1) || board_graph.IsAdjacent(previous_index, hovered_tile)))
+                        {
+                            activated[row][column] = 1;
+                            for (const char* letter = visible_character; *letter; letter++)
+                            {
+                                word[word_length++] = *letter;
+                            }
+                            word[word_length] = 0;
+                            word_cursor.Push(visible_character);
+                            word_changed = true;
+                            tile_path_id[path_length] = ImVec2(float(row), float(column));
+                            tile_path_pos[path_length++] = tile_centers[row][column];
+                            previous_tile = ImVec2(float(row), float(column));
+                        }
+                        else if (path_length > 1 && tile_path_id[path_length - 2].x == row && tile_path_id[path_length - 2].y == column)
+                        {
+                            // Dragging back onto the tile before the last one retracts the last one
+                            const ImVec2 retracted = tile_path_id[--path_length];
+                            activated[int(retracted.x)][int(retracted.y)] = 0;
+                            word_cursor.Pop();
+                            word_length = word_cursor.Letters();
+                            word[word_length] = 0;
+                            word_changed = true;
+                            previous_tile = ImVec2(float(row), float(column));
+                        }
+                    }
+
+                    // Draw selection path, on top of the tiles in the same draw list
+                    ImDrawList* board_draw_list = ImGui::GetWindowDrawList();
+                    DrawSelectionPath(board_draw_list, tile_path_pos, path_length, line_color, line_thickness);
+                    if (game_phase == WordHuntGamePhase_Play && path_length && ImGui::IsMouseDown(ImGuiMouseButton_Left))
+                    {
+                        board_draw_list->AddLine(tile_path_pos[path_length - 1], io.MousePos, line_color, line_thickness);
+                        board_draw_list->AddCircleFilled(io.MousePos, line_thickness / 2, line_color);
+                    }
+
 
                     // WORD DETECTION LOGIC
                     if (game_phase == WordHuntGamePhase_Play)
@@ -555,21 +692,47 @@ int main(int, char**)
                                 previous_word[i] = word[i];
                             }
                             word_length = 0;
-
-                            previous_word_str = std::string(previous_word, previous_word + previous_word_length);
-                            if (previous_word_length > 2 && current_dictionary->IsWord(previous_word_str) && found_words.find(previous_word_str) == found_words.end())
+                            const int previous_path_length = path_length;
+                            path_length = 0;
+
+                            // Blanks are resolved in place to the letters of the first word they can form
+                            const int word_id = previous_word_length >= WordHunt::GetMinWordLength() && word_cursor.Resolve(previous_word) ? solver->WordId(word_cursor.WordNode()) : -1;
+                            word_cursor.Clear();
+                            word_changed = true;
+                            if (word_id >= 0 && !found_ids.TestBit(word_id))
                             {
-                                found_words.insert(previous_word_str);
-                                std::cout << previous_word_str << "\t\t of length [" << previous_word_length;
-                                Tile* head = new Tile((int)tile_path_id[0].x, (int)tile_path_id[0].y, letters[(int)(tile_path_id[0].x * num_rows + tile_path_id[0].y) * 2]);
-                                Tile* temp = head;
-                                for (int i = 1; i < previous_word_length; i++)
+                                found_ids.SetBit(word_id);
+                                int insert_at = found_list.Size;
+                                while (insert_at > 0 && found_list[insert_at - 1] > word_id)
                                 {
-                                    temp->next = new Tile((int)tile_path_id[i].x, (int)tile_path_id[i].y, letters[(int)(tile_path_id[i].x * num_rows + tile_path_id[i].y) * 2]);
-                                    temp = temp->next;
+                                    insert_at--;
                                 }
-                                discovered.insert(new Solution(head));
-                                std::cout << "] is successfully added to [discovered]\n";
+                                found_list.insert(found_list.Data + insert_at, word_id);
+                                found_count++;
+                                found_points += solver->words[word_id]->GetPointValue();
+                                Tile* head = NULL;
+                                Tile* temp = NULL;
+                                int letter_offset = 0;
+                                for (int i = 0; i < previous_path_length; i++)
+                                {
+                                    // Take the tile's letters from the resolved word so blanks keep the letter they stood for
+                                    char resolved_tile[WORDHUNT_TILE_STRIDE] = { 0 };
+                                    int tile_length = (int)strlen(WordHunt::GetTile(letters, (int)(tile_path_id[i].x * num_columns + tile_path_id[i].y)));
+                                    memcpy(resolved_tile, &previous_word[letter_offset], tile_length);
+                                    letter_offset += tile_length;
+
+                                    Tile* tile = session_arena.New<Tile>((int)tile_path_id[i].x, (int)tile_path_id[i].y, resolved_tile);
+                                    if (temp)
+                                    {
+                                        temp->next = tile;
+                                    }
+                                    else
+                                    {
+                                        head = tile;
+                                    }
+                                    temp = tile;
+                                }
+                                WHGui::BuildSolutionItem(&found_items[word_id], session_arena.New<Solution>(head), "found words");
                             }
                             previous_tile = ImVec2(-1, -1);
                             memset(activated, 0, sizeof(activated));
@@ -593,35 +756,43 @@ int main(int, char**)
                     {
                         ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, 5.0f);
                         ImGui::Text("WORDS FOUND");
+                        const int word_total = (int)solver->words.size();
+                        ImGui::Text("%d / %d words, %d / %d points (%.0f%%)", found_count, word_total, found_points, solver->total_points,
+                            word_total ? 100.0f * found_count / word_total : 0.0f);
                         ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(0, 0, 0, 255));
-                        ImGui::PushFont(io.Fonts->Fonts[NotoSerifRegular * 10 + FontSize_20px]);
+                        ImGui::PushFont(WHGui::FontRetrieve(NotoSerifRegular, FontSize_20px, styler->SolutionItemGlyphs));
 
 
                         static const ImVec2 solution_size = ImVec2(0, 25);
-                        for (Solution* a : discovered)
+                        // IDs follow the solver's order, longest words first. Only the rows in view are submitted.
+                        ImGuiListClipper found_clipper;
+                        found_clipper.Begin(found_list.Size, solution_size.y + style.ItemSpacing.y);
+                        while (found_clipper.Step())
                         {
-                            if (WHGui::SolutionItem(a, solution_size, default_board_color, ImGuiWindowFlags_NoMouseInputs, "found words") && game_phase == WordHuntGamePhase_Result)
+                            for (int row = found_clipper.DisplayStart; row < found_clipper.DisplayEnd; row++)
                             {
-                                word_length = a->length;
-                                Tile* head = a->head;
-                                int i = 0;
-                                while (head)
+                                Solution* a = found_items[found_list[row]].solution;
+                                if (WHGui::SolutionItem(&found_items[found_list[row]], solution_size, default_board_color) && game_phase == WordHuntGamePhase_Result)
                                 {
-                                    tile_path_pos[i++] = tile_centers[head->x][head->y];
-                                    activated[head->x][head->y] = true;
-                                    head = head->next;
-                                }
-                                line_color = pale_white;
-                                DrawSelectionPath(tile_path_pos, word_length, line_color, line_thickness);
+                                    Tile* head = a->head;
+                                    int i = 0;
+                                    while (head)
+                                    {
+                                        tile_path_pos[i++] = tile_centers[head->x][head->y];
+                                        activated[head->x][head->y] = true;
+                                        head = head->next;
+                                    }
+                                    line_color = pale_white;
+                                    DrawSelectionPath(ImGui::GetForegroundDrawList(), tile_path_pos, i, line_color, line_thickness);
 
-                                head = a->head;
-                                i = 0;
-                                while (head)
-                                {
-                                    activated[head->x][head->y] = false;
-                                    head = head->next;
+                                    head = a->head;
+                                    i = 0;
+                                    while (head)
+                                    {
+                                        activated[head->x][head->y] = false;
+                                        head = head->next;
+                                    }
                                 }
-                                word_length = 0;
                             }
                         }
                         ImGui::PopFont();
@@ -640,35 +811,39 @@ int main(int, char**)
                             ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, 5.0f);
                             ImGui::Text("POSSIBLE WORDS");
                             ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(0, 0, 0, 255));
-                            ImGui::PushFont(io.Fonts->Fonts[NotoSerifRegular * 10 + FontSize_20px]);
+                            ImGui::PushFont(WHGui::FontRetrieve(NotoSerifRegular, FontSize_20px, styler->SolutionItemGlyphs));
 
 
                             static const ImVec2 solution_size = ImVec2(0, 25);
-                            for (Solution* a : solver->sol_list)
+                            ImGuiListClipper solution_clipper;
+                            solution_clipper.Begin((int)solver->words.size(), solution_size.y + style.ItemSpacing.y);
+                            while (solution_clipper.Step())
                             {
-                                if (WHGui::SolutionItem(a, solution_size, default_board_color, ImGuiWindowFlags_NoMouseInputs, "solution"))
+                                for (int row = solution_clipper.DisplayStart; row < solution_clipper.DisplayEnd; row++)
                                 {
-                                    word_length = a->length;
-                                    Tile* head = a->head;
-
-                                    int i = 0;
-                                    while (head)
+                                    Solution* a = solver->words[row];
+                                    if (WHGui::SolutionItem(&solution_items[row], solution_size, default_board_color))
                                     {
-                                        tile_path_pos[i++] = tile_centers[head->x][head->y];
-                                        activated[head->x][head->y] = true;
-                                        head = head->next;
-                                    }
-                                    line_color = pale_white;
-                                    DrawSelectionPath(tile_path_pos, word_length, line_color, line_thickness);
+                                        Tile* head = a->head;
 
-                                    head = a->head;
-                                    i = 0;
-                                    while (head)
-                                    {
-                                        activated[head->x][head->y] = false;
-                                        head = head->next;
+                                        int i = 0;
+                                        while (head)
+                                        {
+                                            tile_path_pos[i++] = tile_centers[head->x][head->y];
+                                            activated[head->x][head->y] = true;
+                                            head = head->next;
+                                        }
+                                        line_color = pale_white;
+                                        DrawSelectionPath(ImGui::GetForegroundDrawList(), tile_path_pos, i, line_color, line_thickness);
+
+                                        head = a->head;
+                                        i = 0;
+                                        while (head)
+                                        {
+                                            activated[head->x][head->y] = false;
+                                            head = head->next;
+                                        }
                                     }
-                                    word_length = 0;
                                 }
                             }
                             ImGui::PopFont();
@@ -740,6 +915,21 @@ int main(int, char**)
             ImGui::RenderPlatformWindowsDefault(nullptr, (void*)g_pd3dCommandList);
         }
 
+        // Tooltips open after a hover delay and the text cursor blinks without any input
+        if (ImGui::IsAnyItemHovered() || io.WantTextInput)
+        {
+            idle_timeout = ImMin(idle_timeout, 0.1f);
+        }
+        if (WHGui::HasPendingFonts())
+        {
+            idle_timeout = 0.0f;
+        }
+        if (drawn_phase != game_phase)
+        {
+            drawn_phase = game_phase;
+            frames_to_draw = idle_settle_frames;
+        }
+
         g_pSwapChain->Present(1, 0); // Present with vsync
         //g_pSwapChain->Present(0, 0); // Present without vsync
 
@@ -750,10 +940,15 @@ int main(int, char**)
     }
 
     WaitForLastSubmittedFrame();
+    if (solve_thread.joinable())
+    {
+        solve_thread.join();
+    }
 
     // Cleanup
     ImGui_ImplDX12_Shutdown();
     ImGui_ImplWin32_Shutdown();
+    WHGui::UnloadFonts();
     ImGui::DestroyContext();
 
     CleanupDeviceD3D();
@@ -924,6 +1119,17 @@ void CleanupRenderTarget()
         if (g_mainRenderTargetResource[i]) { g_mainRenderTargetResource[i]->Release(); g_mainRenderTargetResource[i] = nullptr; }
 }
 
+// Sleeps until a message is queued for this thread or timeout_seconds pass, FLT_MAX waits for a message only
+void WaitForInputOrTimeout(double timeout_seconds)
+{
+    DWORD timeout_ms = INFINITE;
+    if (timeout_seconds < 86400.0)
+    {
+        timeout_ms = (DWORD)(timeout_seconds * 1000.0 + 0.999);
+    }
+    ::MsgWaitForMultipleObjectsEx(0, nullptr, timeout_ms, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+}
+
 void WaitForLastSubmittedFrame()
 {
     FrameContext* frameCtx = &g_frameContext[g_frameIndex % NUM_FRAMES_IN_FLIGHT];
@@ -1001,12 +1207,12 @@ LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 
 
 
-bool DrawSelectionPath(const ImVec2* tile_path_pos, const int word_length, ImU32 line_color, const float line_thickness)
+bool DrawSelectionPath(ImDrawList* draw_list, const ImVec2* tile_path_pos, const int word_length, ImU32 line_color, const float line_thickness)
 {
     for (int i = 1; i < word_length; i++)
     {
-        ImGui::GetForegroundDrawList()->AddLine(tile_path_pos[i - 1], tile_path_pos[i], line_color, line_thickness);
-        ImGui::GetForegroundDrawList()->AddCircleFilled(tile_path_pos[i - 1], line_thickness / 2, line_color);
+        draw_list->AddLine(tile_path_pos[i - 1], tile_path_pos[i], line_color, line_thickness);
+        draw_list->AddCircleFilled(tile_path_pos[i - 1], line_thickness / 2, line_color);
     }
     return true;
 }
@@ -5,7 +5,20 @@
 // [SECTION] WORDHUNT FUNCTIONS
 
 #include "wordhunt.h"
+#include <atomic>
+#include <climits>
 #include <random>
+#include <thread>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 //-------------------------------------------------------------------------
 // [SECTION] STRUCT CONSTRUCTOR
@@ -19,6 +32,9 @@ LetterNode::LetterNode(bool _end_of_word, char _letter)
     hasChildren = false;
     children = nullptr;
     isChild = nullptr;
+    child_mask = 0;
+    required_mask = 0;
+    min_remaining = 0;
 }
 
 // [STRUCT] Dictionary
@@ -41,16 +57,57 @@ void Dictionary::AddWord(char* word, size_t word_length)
         {
             current->isChild[word[index] - 'A'] = true;
             current->children[word[index] - 'A'] = new LetterNode(index == word_length - 1, word[index]);
+            current->child_mask |= 1u << (word[index] - 'A');
         }
         current = current->children[word[index] - 'A'];
     }
+    current->end_of_word = true;
 }
 
-bool Dictionary::IsWord(const char* word, size_t word_length)
+static void ComputeNodeRequirements(LetterNode* node)
+{
+    // A word ending here needs nothing more, otherwise every completion goes through one of the children
+    node->required_mask = node->end_of_word ? 0 : ~0u;
+    node->min_remaining = node->end_of_word ? 0 : 255;
+    for (unsigned int mask = node->child_mask; mask; mask &= mask - 1)
+    {
+        int letter = WordHunt::LowestBit(mask);
+        LetterNode* child = node->children[letter];
+        ComputeNodeRequirements(child);
+        node->required_mask &= (1u << letter) | child->required_mask;
+        if (child->min_remaining + 1 < node->min_remaining)
+        {
+            node->min_remaining = (unsigned char)(child->min_remaining + 1);
+        }
+    }
+}
+
+void Dictionary::ComputeRequirements()
+{
+    ComputeNodeRequirements(head);
+}
+
+static bool MatchWord(LetterNode* current, const char* word, size_t word_length, char* resolved)
 {
-    LetterNode* current = head;
     for (size_t index = 0; index < word_length; index++)
     {
+        if (word[index] == WORDHUNT_BLANK)
+        {
+            // Only branch over letters that actually continue the trie
+            for (unsigned int mask = current->child_mask; mask; mask &= mask - 1)
+            {
+                int letter = WordHunt::LowestBit(mask);
+                if (MatchWord(current->children[letter], word + index + 1, word_length - index - 1, resolved ? resolved + index + 1 : NULL))
+                {
+                    if (resolved)
+                    {
+                        resolved[index] = char('A' + letter);
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
         if (!isalpha(word[index]) || !current->hasChildren)
         {
             return false;
@@ -63,202 +120,356 @@ bool Dictionary::IsWord(const char* word, size_t word_length)
         {
             return false;
         }
+        if (resolved)
+        {
+            resolved[index] = word[index];
+        }
     }
     return current->end_of_word;
 }
 
+bool Dictionary::IsWord(const char* word, size_t word_length, char* resolved)
+{
+    return MatchWord(head, word, word_length, resolved);
+}
+
+// [STRUCT] TrieCursor
+void TrieCursor::Reset(Dictionary* _dictionary)
+{
+    dictionary = _dictionary;
+    Clear();
+}
+
+// Entries of a level are in order of the letters their blanks took, so the first word entry is the match
+// MatchWord() would find
+bool TrieCursor::Push(const char* tile)
+{
+    const TileCode code(tile);
+    Level level;
+    level.begin = (int)entries.size();
+    level.word_entry = -1;
+    level.letters = Letters() + (code.blank ? 1 : code.length);
+    level.is_prefix = false;
+    memset(level.tile, 0, sizeof(level.tile));
+    memcpy(level.tile, tile, code.blank ? 1 : code.length);
+
+    const int parent_begin = levels.empty() ? -1 : levels.back().begin;
+    const int parent_end = levels.empty() ? 0 : level.begin;
+    for (int parent = parent_begin; parent < parent_end; parent++)
+    {
+        LetterNode* node = parent < 0 ? dictionary->head : entries[parent].node;
+        if (code.blank)
+        {
+            for (unsigned int mask = node->child_mask; mask; mask &= mask - 1)
+            {
+                const int letter = WordHunt::LowestBit(mask);
+                Entry entry = { node->children[letter], parent, char('A' + letter) };
+                entries.push_back(entry);
+            }
+        }
+        else if (LetterNode* next = WordHunt::AdvanceTile(node, code))
+        {
+            Entry entry = { next, parent, 0 };
+            entries.push_back(entry);
+        }
+    }
+    for (int i = level.begin; i < (int)entries.size(); i++)
+    {
+        if (entries[i].node->end_of_word && level.word_entry < 0)
+        {
+            level.word_entry = i;
+        }
+        level.is_prefix |= entries[i].node->child_mask != 0;
+    }
+    levels.push_back(level);
+    return level.is_prefix || level.word_entry >= 0;
+}
+
+void TrieCursor::Pop()
+{
+    if (!levels.empty())
+    {
+        entries.resize(levels.back().begin);
+        levels.pop_back();
+    }
+}
+
+bool TrieCursor::Resolve(char* out) const
+{
+    if (!IsWord())
+    {
+        return false;
+    }
+    out[Letters()] = 0;
+    int entry = levels.back().word_entry;
+    for (int depth = Depth() - 1; depth >= 0; depth--)
+    {
+        const Level& level = levels[depth];
+        const int start = depth ? levels[depth - 1].letters : 0;
+        if (entries[entry].letter)
+        {
+            out[start] = entries[entry].letter;
+        }
+        else
+        {
+            memcpy(&out[start], level.tile, level.letters - start);
+        }
+        entry = entries[entry].parent;
+    }
+    return true;
+}
+
+// [STRUCT] TileCode
+TileCode::TileCode(const char* tile)
+{
+    length = 0;
+    blank = tile[0] == WORDHUNT_BLANK;
+    while (length < WORDHUNT_MAX_TILE_LEN && isalpha(tile[length]))
+    {
+        index[length] = (unsigned char)(toupper(tile[length]) - 'A');
+        length++;
+    }
+}
+
 // [STRUCT] Solution
 Solution::Solution(Tile* _head)
 {
     head = _head;
     Tile* temp = head;
 
-    word = new char[16];
     length = 0;
     while (temp)
     {
-        word[length++] = temp->val;
+        length += (int)strlen(temp->val);
         temp = temp->next;
     }
-    word[length] = 0;
-}
 
-char* Solution::to_string()
-{
-    char out[16];
-    for (int i = 0; i < length; i++)
+    word = (char*)WordHunt::SessionAlloc(length + 1, 1);
+    length = 0;
+    temp = head;
+    while (temp)
     {
-        out[i] = word[i];
+        for (const char* c = temp->val; *c; c++)
+        {
+            word[length++] = *c;
+        }
+        temp = temp->next;
     }
-    out[length] = 0;
-    return _strdup(out);
+    word[length] = 0;
 }
 
 // [STRUCT] Seed
 Seed::Seed(unsigned int _seed_value)
 {
     seed_value = _seed_value;
-    rows = 4;
-    cols = 4;
     time_seconds = 75;
+    blanks = 0;
+    layout = BoardLayout_Square;
+    generator = SeedGenerator_Latest;
+    SetShape(4, 4, true);
+}
+
+Seed::Seed(const char* _complete_seed)
+{
+    *this = Seed(0u);
+    WordHunt::ParseSeed(_complete_seed, this);
+}
+
+int Seed::to_string(char* buffer, const size_t buffer_size) const
+{
+    return WordHunt::FormatSeed(this, buffer, buffer_size);
+}
+
+// Bits past rows * cols stay clear so equal boards compare and hash equal
+void Seed::SetShape(int _rows, int _cols, bool active)
+{
+    rows = (unsigned char)_rows;
+    cols = (unsigned char)_cols;
     memset(board, 0, sizeof(board));
-    for (int row = 0; row < rows; row++)
+    const int tile_count = rows * cols;
+    for (int word = 0; active && word * 32 < tile_count; word++)
     {
-        for (int col = 0; col < cols; col++)
-        {
-            board[row][col] = 1;
-        }
+        board[word] = tile_count - word * 32 >= 32 ? ~0u : (1u << (tile_count - word * 32)) - 1;
     }
 }
 
-Seed::Seed(char* _complete_seed)
+void Seed::SetActive(int row, int col, bool active)
 {
-    memset(board, 0, sizeof(board));
-
-    int index = 0;
-    if (_complete_seed[index] == 'R')
+    const int tile_index = row * cols + col;
+    if (active)
     {
-        rows = 0; // Get rows
-        index++; // skip 'R'
-        while (isdigit(_complete_seed[index]))
-        {
-            rows *= 10;
-            rows += _complete_seed[index++] - '0';
-        }
-
-        cols = 0; // Get cols
-        index++; // skip 'C'
-        while (isdigit(_complete_seed[index]))
-        {
-            cols *= 10;
-            cols += _complete_seed[index++] - '0';
-        }
-
-        // Get board layout
-        index++; // skip '>'
-        for (int r = 0; r < rows; r++)
-        {
-            for (int c = 0; c < cols; c++)
-            {
-                board[r][c] = _complete_seed[index++] - '0';
-            }
-        }
-
-        seed_value = 0; // Get seed_value
-        index++; // skip '['
-        while (isdigit(_complete_seed[index]))
-        {
-            seed_value *= 10;
-            seed_value += _complete_seed[index++] - '0';
-        }
-        index++; // skip ']'
-        index++; // skip 't'
-        time_seconds = 0;
-        while (isdigit(_complete_seed[index]))
-        {
-            time_seconds *= 10;
-            time_seconds += _complete_seed[index++] - '0';
-        }
+        board[tile_index >> 5] |= 1u << (tile_index & 31);
     }
     else
     {
-        index++;
-        seed_value = 0;
-        while (isdigit(_complete_seed[index]))
-        {
-            seed_value *= 10;
-            seed_value += _complete_seed[index++] - '0';
-        }
-        rows = 4;
-        cols = 4;
-        index++;
-        time_seconds = 75;
+        board[tile_index >> 5] &= ~(1u << (tile_index & 31));
+    }
+}
+
+int Seed::ActiveCount() const
+{
+    int count = 0;
+    for (int word = 0; word < WORDHUNT_SEED_BOARD_WORDS; word++)
+    {
+        count += WordHunt::BitCount(board[word]);
+    }
+    return count;
+}
 
-        for (int row = 0; row < rows; row++)
+int Seed::NextActive(int tile_index) const
+{
+    tile_index++;
+    int word = tile_index >> 5;
+    if (word >= WORDHUNT_SEED_BOARD_WORDS)
+    {
+        return -1;
+    }
+    unsigned int mask = board[word] & (~0u << (tile_index & 31));
+    while (!mask)
+    {
+        if (++word == WORDHUNT_SEED_BOARD_WORDS)
         {
-            for (int col = 0; col < cols; col++)
-            {
-                board[row][col] = 1;
-            }
+            return -1;
         }
+        mask = board[word];
     }
+    return word * 32 + WordHunt::LowestBit(mask);
 }
 
-char* Seed::to_string()
+size_t Seed::Hash() const
 {
-    std::string output = "";
+    unsigned long long hash = (unsigned long long)seed_value << 32 | (unsigned long long)time_seconds << 16 | (unsigned long long)rows << 8 | cols;
+    hash ^= (unsigned long long)blanks << 56 | (unsigned long long)layout << 48 | (unsigned long long)generator << 40;
+    for (int word = 0; word < WORDHUNT_SEED_BOARD_WORDS; word++)
+    {
+        hash = (hash ^ board[word]) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 29;
+    }
+    return (size_t)hash;
+}
 
-    output.push_back('R');
-    output.push_back(char(rows + '0'));
+bool Seed::operator==(const Seed& other) const
+{
+    return seed_value == other.seed_value && time_seconds == other.time_seconds && rows == other.rows && cols == other.cols
+        && blanks == other.blanks && layout == other.layout && generator == other.generator && memcmp(board, other.board, sizeof(board)) == 0;
+}
 
-    output.push_back('C');
-    output.push_back(char(cols + '0'));
+// [STRUCT] SessionArena
+SessionArena::~SessionArena()
+{
+    Reset();
+    for (Block& block : blocks)
+    {
+        ::operator delete(block.data);
+    }
+}
 
-    output.push_back('>');
-    for (int r = 0; r < rows; r++)
+void* SessionArena::Alloc(size_t size, size_t alignment)
+{
+    size = size ? size : 1;
+    while (block_index < (int)blocks.size())
     {
-        for (int c = 0; c < cols; c++)
+        const Block& block = blocks[block_index];
+        const size_t address = (size_t)(block.data + block_used);
+        const size_t offset = (alignment - (address & (alignment - 1))) & (alignment - 1);
+        if (block_used + offset + size <= block.size)
         {
-            output.push_back(char(board[r][c] + '0'));
+            void* p = block.data + block_used + offset;
+            block_used += offset + size;
+            return p;
         }
+        block_index++;
+        block_used = 0;
     }
 
-    output.push_back('[');
+    // Out of blocks: a new one, operator new aligns it for any fundamental type
+    Block block;
+    block.size = size + alignment > block_size ? size + alignment : block_size;
+    block.data = (char*)::operator new(block.size);
+    blocks.push_back(block);
+    block_index = (int)blocks.size() - 1;
+    block_used = 0;
+    return Alloc(size, alignment);
+}
 
-    char temp[10] = { 0 };
-    int start = 9;
-    unsigned int temp_seed_value = seed_value;
-    while (temp_seed_value && start >= 0)
-    {
-        temp[start] = "0123456789"[temp_seed_value % 10];
-        start--;
-        temp_seed_value /= 10;
-    }
-    while (start < 9)
+void SessionArena::Reset()
+{
+    for (size_t i = destructors.size(); i > 0; i--)
     {
-        output.push_back(temp[++start]);
+        destructors[i - 1].destroy(destructors[i - 1].object);
     }
+    destructors.clear();
+    block_index = 0;
+    block_used = 0;
+}
 
-    output.push_back(']');
-    output.push_back('t');
-    int temp_time_seconds = time_seconds;
-    start = 9;
-    while (temp_time_seconds && start >= 0)
+size_t SessionArena::BytesReserved() const
+{
+    size_t size = 0;
+    for (const Block& block : blocks)
     {
-        temp[start] = "0123456789"[temp_time_seconds % 10];
-        start--;
-        temp_time_seconds /= 10;
+        size += block.size;
     }
-    while (start < 9)
+    return size;
+}
+
+// [STRUCT] BoardGraph
+bool BoardGraph::IsAdjacent(int a, int b) const
+{
+    if (a < 0 || a >= TileCount())
     {
-        output.push_back(temp[++start]);
+        return false;
     }
-
-
-    static char out[256] = { 0 };
-    for (int i = 0; i < output.size(); i++)
+    for (int i = offsets[a]; i < offsets[a + 1]; i++)
     {
-        out[i] = output[i];
+        if (neighbors[i] == b)
+        {
+            return true;
+        }
     }
-    out[output.size()] = 0;
-    return out;
+    return false;
 }
 
 // [STRUCT] Solver
 Solver::Solver(char* letters, Seed* seed)
 {
-    for (int row = 0; row < seed->rows; row++)
+    WordHunt::BuildBoardGraph(&graph, seed);
+    for (int tile_index = 0; tile_index < graph.TileCount(); tile_index++)
+    {
+        const char* tile = WordHunt::GetTile(letters, tile_index);
+        tiles.push_back(tile);
+        codes.push_back(TileCode(tile));
+    }
+    visited = std::vector<char>(graph.TileCount(), 0);
+    sol_list = std::set<Solution*, SolutionPointerComparator>();
+    total_points = 0;
+
+    // First letters each tile's neighbors can continue a word with, a blank neighbor allows every letter
+    neighbor_mask = std::vector<unsigned int>(graph.TileCount(), 0);
+    blank_memo = std::vector<std::unordered_map<const LetterNode*, unsigned int>>(graph.TileCount());
+    for (int tile_index = 0; tile_index < graph.TileCount(); tile_index++)
     {
-        grid.push_back(std::vector<char>());
-        for (int col = 0; col < seed->cols; col++)
+        for (int i = graph.offsets[tile_index]; i < graph.offsets[tile_index + 1]; i++)
         {
-            grid[row].push_back(letters[(row * seed->rows + col) * 2]);
+            const TileCode& code = codes[graph.neighbors[i]];
+            if (code.blank)
+            {
+                neighbor_mask[tile_index] = (1u << 26) - 1;
+            }
+            else if (code.length)
+            {
+                neighbor_mask[tile_index] |= 1u << code.index[0];
+            }
         }
     }
-    visited = std::vector<std::vector<bool>>(seed->rows, std::vector<bool>(seed->cols, false));
-    sol_list = std::set<Solution*, SolutionPointerComparator>();
 };
 
+int Solver::WordId(const LetterNode* node) const
+{
+    auto found = word_ids.find(node);
+    return found != word_ids.end() ? found->second : -1;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] WORDHUNT CONSTRUCTORS
 //-------------------------------------------------------------------------
@@ -269,7 +480,9 @@ static std::vector<Dictionary*> dictionaries;
 static int                      min_word_length;
 static int                      max_points;
 static const int                point_values[] = { 0,0,0,100,400,800,1200,1600,2000,2400,2800 };
+static const int                point_values_count = sizeof(point_values) / sizeof(point_values[0]);
 static Seed*                    current_seed;
+static SessionArena*            session_arena;
 
 // Variable Getters and Setters
 int WordHunt::GetMinWordLength()
@@ -294,6 +507,11 @@ void WordHunt::SetMaxPoints(const int _max_points)
 
 int WordHunt::GetPointVal(const int word_length)
 {
+    // Multi-letter tiles make words longer than the table reachable; keep adding 400 per letter
+    if (word_length >= point_values_count)
+    {
+        return point_values[point_values_count - 1] + 400 * (word_length - point_values_count + 1);
+    }
     return point_values[word_length];
 }
 
@@ -322,17 +540,166 @@ Seed* WordHunt::GetCurrentSeed()
     return current_seed;
 }
 
+void WordHunt::SetSessionArena(SessionArena* _arena)
+{
+    session_arena = _arena;
+}
+
+SessionArena* WordHunt::GetSessionArena()
+{
+    return session_arena;
+}
+
+// Raw memory for the running game, see WordHunt::SessionNew()
+void* WordHunt::SessionAlloc(const size_t size, const size_t alignment)
+{
+    return session_arena ? session_arena->Alloc(size, alignment) : ::operator new(size);
+}
+
+// Letters of SeedGenerator_MT19937 boards, one tile each, drawn uniformly. Unchanged since the first shared seeds.
+static const char legacy_letter_set[] = "EEEEEEEEEEEEAAAAAAAAAIIIIIIIIIOOOOOOOONNNNNNRRRRRRTTTTTTLLLLSSSSUUUUDDDDGGGBBCCMMPPFFHHVVWWYYKJXQZ";
+static const int legacy_letter_set_count = sizeof(legacy_letter_set) - 1;
+
+// Tile distribution of the newer generators, a tile is drawn uniformly from this list: the legacy letters with QU in place of Q, plus TH and ER
+static const char* tile_set[] =
+{
+    "E","E","E","E","E","E","E","E","E","E","E","E","A","A","A","A","A","A","A","A","A","I","I","I","I","I","I","I","I","I",
+    "O","O","O","O","O","O","O","O","N","N","N","N","N","N","R","R","R","R","R","R","T","T","T","T","T","T","L","L","L","L",
+    "S","S","S","S","U","U","U","U","D","D","D","D","G","G","G","B","B","C","C","M","M","P","P","F","F","H","H","V","V","W",
+    "W","Y","Y","K","J","X","QU","Z","TH","ER"
+};
+static const int tile_set_count = sizeof(tile_set) / sizeof(tile_set[0]);
+
+const char* const* WordHunt::GetTileSet(int* count)
+{
+    *count = tile_set_count;
+    return tile_set;
+}
+
+// PCG32, XSH RR variant (O'Neill, pcg-random.org): 64-bit LCG state, 32-bit output.
+// Spelled out here so SeedGenerator_PCG32 boards never depend on the standard library.
+struct SeedRandom
+{
+    unsigned long long  state;
+    unsigned long long  increment;
+
+    SeedRandom(unsigned long long seed, unsigned long long stream)
+    {
+        state = 0;
+        increment = stream << 1 | 1;
+        Next();
+        state += seed;
+        Next();
+    }
+    unsigned int Next()
+    {
+        const unsigned long long old_state = state;
+        state = old_state * 6364136223846793005ull + increment;
+        const unsigned int xorshifted = (unsigned int)(((old_state >> 18) ^ old_state) >> 27);
+        const unsigned int rotation = (unsigned int)(old_state >> 59);
+        return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+    }
+    // Uniform in [0, bound), bound > 0. Lemire's multiply-shift, the division only runs on the rare retry path.
+    unsigned int Below(unsigned int bound)
+    {
+        unsigned long long product = (unsigned long long)Next() * bound;
+        if ((unsigned int)product < bound)
+        {
+            const unsigned int threshold = (0u - bound) % bound;
+            while ((unsigned int)product < threshold)
+            {
+                product = (unsigned long long)Next() * bound;
+            }
+        }
+        return (unsigned int)(product >> 32);
+    }
+};
+
+// tile_set padded to WORDHUNT_TILE_STRIDE, so a tile is written with one fixed-size copy
+static const struct TileStrides
+{
+    char tiles[tile_set_count][WORDHUNT_TILE_STRIDE];
+
+    TileStrides()
+    {
+        memset(tiles, 0, sizeof(tiles));
+        for (int i = 0; i < tile_set_count; i++)
+        {
+            memcpy(tiles[i], tile_set[i], strlen(tile_set[i]));
+        }
+    }
+} tile_strides;
+
+// Streams of one seed value, tiles and blanks draw from separate sequences
+#define WORDHUNT_STREAM_TILES       0
+#define WORDHUNT_STREAM_BLANKS      1
+
 // Setup function
-void WordHunt::GenerateGame(char* s, const size_t len, int _seed)
+// Writes 'len' tiles into 's' (WORDHUNT_TILE_STRIDE bytes per tile), 's' must hold len * WORDHUNT_TILE_STRIDE + 1 bytes
+void WordHunt::GenerateGame(char* s, const size_t len, int _seed, const int generator)
+{
+    if (generator == SeedGenerator_MT19937)
+    {
+        // The draw of the first release, pick for pick: boards of seeds shared before generators were recorded depend on it
+        std::mt19937 rng(_seed);
+        for (size_t i = 0; i < len; i++) {
+            char* tile = &s[i * WORDHUNT_TILE_STRIDE];
+            memset(tile, 0, WORDHUNT_TILE_STRIDE);
+            tile[0] = legacy_letter_set[std::uniform_int_distribution<int>(0, legacy_letter_set_count - 1)(rng)];
+        }
+    }
+    else
+    {
+        SeedRandom rng((unsigned int)_seed, WORDHUNT_STREAM_TILES);
+        for (size_t i = 0; i < len; i++)
+        {
+            memcpy(&s[i * WORDHUNT_TILE_STRIDE], tile_strides.tiles[rng.Below(tile_set_count)], WORDHUNT_TILE_STRIDE);
+        }
+    }
+    s[len * WORDHUNT_TILE_STRIDE] = 0;
+}
+
+// Turns active[pick] into a blank and takes it out of the list, keeping the order of the others
+static void PlaceBlank(char* s, int* active, int* active_count, const int pick)
+{
+    char* tile = WordHunt::GetTile(s, active[pick]);
+    memset(tile, 0, WORDHUNT_TILE_STRIDE);
+    tile[0] = WORDHUNT_BLANK;
+    memmove(&active[pick], &active[pick + 1], (*active_count - pick - 1) * sizeof(int));
+    (*active_count)--;
+}
+
+// Draws the tiles for 'seed', then turns seed->blanks of its active tiles into blanks
+void WordHunt::GenerateGame(char* s, const size_t len, Seed* seed)
 {
-    std::mt19937 rng(_seed);
-    const static char* characterSet = "EEEEEEEEEEEEAAAAAAAAAIIIIIIIIIOOOOOOOONNNNNNRRRRRRTTTTTTLLLLSSSSUUUUDDDDGGGBBCCMMPPFFHHVVWWYYKJXQZ";
-    for (size_t i = 0; i < len * 2; i += 2) {
-        s[i] = characterSet[std::uniform_int_distribution<int>(0, 97)(rng)];
-        s[i + 1] = 0;
+    GenerateGame(s, len, seed->seed_value, seed->generator);
+    if (!seed->blanks)
+    {
+        return;
+    }
+
+    int active[WORDHUNT_MAX_SIDE * WORDHUNT_MAX_SIDE];
+    int active_count = 0;
+    for (int tile_index = seed->NextActive(-1); tile_index >= 0 && size_t(tile_index) < len; tile_index = seed->NextActive(tile_index))
+    {
+        active[active_count++] = tile_index;
+    }
+    if (seed->generator == SeedGenerator_MT19937)
+    {
+        std::mt19937 rng(seed->seed_value ^ 0x9E3779B9u);
+        for (int i = 0; i < seed->blanks && active_count > 0; i++)
+        {
+            PlaceBlank(s, active, &active_count, std::uniform_int_distribution<int>(0, active_count - 1)(rng));
+        }
+    }
+    else
+    {
+        SeedRandom rng(seed->seed_value, WORDHUNT_STREAM_BLANKS);
+        for (int i = 0; i < seed->blanks && active_count > 0; i++)
+        {
+            PlaceBlank(s, active, &active_count, (int)rng.Below((unsigned int)active_count));
+        }
     }
-    std::cout << "\n";
-    s[len * 2] = 0;
 }
 
 Dictionary* WordHunt::AddDictionary(const char* fileName)
@@ -354,111 +721,289 @@ Dictionary* WordHunt::AddDictionary(const char* fileName)
         new_dictionary->AddWord(buffer, word_size);
         word_size = 0;
     }
+    new_dictionary->ComputeRequirements();
     dictionaries.push_back(new_dictionary);
     return new_dictionary;
 }
 
-int WordHunt::IsValidSeed(char* potential_seed)
+// Reads 1 to 'max_digits' digits no greater than 'max_value', an empty number reads as 0 when 'allow_empty'
+static bool ParseSeedNumber(const char** cursor, const int max_digits, const unsigned int max_value, const bool allow_empty, unsigned int* out)
 {
-    int index = 0;
-    if (potential_seed[index] == 'R')
+    const char* p = *cursor;
+    unsigned long long value = 0;
+    int digits = 0;
+    while (*p >= '0' && *p <= '9')
     {
-        // Check rows
-        int temp_rows = 0;
-        index++;
-        while (isdigit(potential_seed[index]) && temp_rows < 20)
+        if (++digits > max_digits)
         {
-            temp_rows *= 10;
-            temp_rows += potential_seed[index++] - '0';
+            return false;
         }
+        value = value * 10 + (unsigned long long)(*p++ - '0');
+    }
+    if ((!digits && !allow_empty) || value > max_value)
+    {
+        return false;
+    }
+    *cursor = p;
+    *out = (unsigned int)value;
+    return true;
+}
 
-        if (temp_rows > 15 || temp_rows == 0)
+// Single pass over the seed grammar documented on Seed, 'out' (optional) is only written when the seed is valid.
+// Returns 1 for the full form, 0 for the short "[seed]" form and -1 for an invalid seed.
+int WordHunt::ParseSeed(const char* text, Seed* out)
+{
+    Seed seed(0u);
+    seed.generator = SeedGenerator_MT19937; // Text without a "v#" token predates generator versions
+    const char* p = text;
+    unsigned int value = 0;
+    int form = 0;
+    if (*p == '[')
+    {
+        p++;
+        if (!ParseSeedNumber(&p, 10, UINT_MAX, false, &seed.seed_value) || *p++ != ']')
         {
             return -1;
         }
-
-        // Check rows
-        int temp_cols = 0;
-        if (potential_seed[index++] != 'C')
+    }
+    else if (*p == 'R')
+    {
+        p++;
+        unsigned int rows = 0, cols = 0;
+        if (!ParseSeedNumber(&p, 2, WORDHUNT_MAX_SIDE, false, &rows) || rows == 0)
         {
             return -1;
         }
-        while (isdigit(potential_seed[index]) && temp_cols < 20)
-        {
-            temp_cols *= 10;
-            temp_cols += potential_seed[index++] - '0';
-        }
-
-        if (temp_cols > 15 || temp_cols == 0)
+        if (*p++ != 'C' || !ParseSeedNumber(&p, 2, WORDHUNT_MAX_SIDE, false, &cols) || cols == 0)
         {
             return -1;
         }
-
-        if (potential_seed[index++] != '>')
+        if (*p++ != '>')
         {
             return -1;
         }
-        for (int r = 0; r < temp_rows; r++)
+        seed.SetShape((int)rows, (int)cols, false);
+        for (int tile_index = 0; tile_index < (int)(rows * cols); tile_index++)
         {
-            for (int c = 0; c < temp_cols; c++)
+            const char c = *p++;
+            if (c != '0' && c != '1')
             {
-                if (potential_seed[index] != '0' && potential_seed[index++] != '1')
-                {
-                    return -1;
-                }
+                return -1;
             }
+            seed.board[tile_index >> 5] |= (unsigned int)(c - '0') << (tile_index & 31);
         }
-
-        if (potential_seed[index++] != '[')
-        {
-            return -1;
-        }
-        long long temp_seed = 0;
-        while (isdigit(potential_seed[index]) && temp_seed < INT_MAX)
-        {
-            temp_seed *= 10;
-            temp_seed += potential_seed[index++] - '0';
-        }
-        if (potential_seed[index++] != ']')
+        // Seeds written before the seed value 0 was spelled out have "[]"
+        if (*p++ != '[' || !ParseSeedNumber(&p, 10, UINT_MAX, true, &seed.seed_value) || *p++ != ']')
         {
             return -1;
         }
-        if (potential_seed[index++] != 't')
+        if (*p++ != 't' || !ParseSeedNumber(&p, 4, 9999, false, &value))
         {
             return -1;
         }
-        int counter = 0;
-        while (potential_seed[index++] != 0)
+        seed.time_seconds = (unsigned short)value;
+        if (*p == 'b')
         {
-            counter++;
+            p++;
+            if (!ParseSeedNumber(&p, 1, 9, false, &value))
+            {
+                return -1;
+            }
+            seed.blanks = (unsigned char)value;
         }
-        return (counter && counter < 5) ? 1 : -1;
-    }
-    else if (potential_seed[index] == '[')
-    {
-        index++;
-        long long hold = 0;
-        while (isdigit(potential_seed[index]) && hold < INT_MAX)
+        if (*p == 'g')
         {
-            hold *= 10;
-            hold += potential_seed[index] - '0';
+            p++;
+            if (!ParseSeedNumber(&p, 1, BoardLayout_COUNT - 1, false, &value))
+            {
+                return -1;
+            }
+            seed.layout = (unsigned char)value;
         }
-        if (isdigit(potential_seed[index]))
+        if (*p == 'v')
         {
-            return -1;
-        }
-        else {
-            return 0;
+            p++;
+            if (!ParseSeedNumber(&p, 1, SeedGenerator_COUNT - 1, false, &value))
+            {
+                return -1;
+            }
+            seed.generator = (unsigned char)value;
         }
+        form = 1;
     }
     else
     {
         return -1;
     }
-}
 
-void WordHunt::Setup(char* file_name)
-{
+    if (*p != 0)
+    {
+        return -1;
+    }
+    if (out)
+    {
+        *out = seed;
+    }
+    return form;
+}
+
+static void FormatSeedChar(char* buffer, const size_t buffer_size, int* length, const char c)
+{
+    if ((size_t)*length + 1 < buffer_size)
+    {
+        buffer[*length] = c;
+    }
+    (*length)++;
+}
+
+static void FormatSeedNumber(char* buffer, const size_t buffer_size, int* length, unsigned int value)
+{
+    char digits[10];
+    int count = 0;
+    do
+    {
+        digits[count++] = char('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (count)
+    {
+        FormatSeedChar(buffer, buffer_size, length, digits[--count]);
+    }
+}
+
+// Writes the full form of 'seed', truncated to buffer_size - 1 characters and always NUL-terminated.
+// Returns the length of the full text, WORDHUNT_SEED_TEXT_MAX always fits.
+int WordHunt::FormatSeed(const Seed* seed, char* buffer, const size_t buffer_size)
+{
+    int length = 0;
+    FormatSeedChar(buffer, buffer_size, &length, 'R');
+    FormatSeedNumber(buffer, buffer_size, &length, (unsigned int)seed->rows);
+    FormatSeedChar(buffer, buffer_size, &length, 'C');
+    FormatSeedNumber(buffer, buffer_size, &length, (unsigned int)seed->cols);
+    FormatSeedChar(buffer, buffer_size, &length, '>');
+    for (int tile_index = 0; tile_index < seed->rows * seed->cols; tile_index++)
+    {
+        FormatSeedChar(buffer, buffer_size, &length, char('0' + ((seed->board[tile_index >> 5] >> (tile_index & 31)) & 1)));
+    }
+    FormatSeedChar(buffer, buffer_size, &length, '[');
+    FormatSeedNumber(buffer, buffer_size, &length, seed->seed_value);
+    FormatSeedChar(buffer, buffer_size, &length, ']');
+    FormatSeedChar(buffer, buffer_size, &length, 't');
+    FormatSeedNumber(buffer, buffer_size, &length, (unsigned int)seed->time_seconds);
+    if (seed->blanks)
+    {
+        FormatSeedChar(buffer, buffer_size, &length, 'b');
+        FormatSeedNumber(buffer, buffer_size, &length, (unsigned int)seed->blanks);
+    }
+    if (seed->layout != BoardLayout_Square)
+    {
+        FormatSeedChar(buffer, buffer_size, &length, 'g');
+        FormatSeedNumber(buffer, buffer_size, &length, (unsigned int)seed->layout);
+    }
+    if (seed->generator != SeedGenerator_MT19937)
+    {
+        FormatSeedChar(buffer, buffer_size, &length, 'v');
+        FormatSeedNumber(buffer, buffer_size, &length, (unsigned int)seed->generator);
+    }
+    if (buffer_size)
+    {
+        buffer[(size_t)length < buffer_size ? length : buffer_size - 1] = 0;
+    }
+    return length;
+}
+
+// Binary seed, little endian:
+//      [0]     (rows - 1) << 4 | (cols - 1)
+//      [1]     layout in bits 0-2, blanks in bits 3-6, bit 7 set when every tile is active
+//      [2..5]  seed_value
+//      [6..7]  time_seconds in bits 0-13, generator in bits 14-15
+//      [8..]   only without bit 7: (rows * cols + 7) / 8 bytes, tile row * cols + col is bit (index % 8) of byte (index / 8)
+// Returns the bytes written, or -1 if the buffer is too small or the seed cannot be written as text either.
+int WordHunt::EncodeSeed(const Seed* seed, unsigned char* buffer, const size_t buffer_size)
+{
+    if (seed->rows < 1 || seed->rows > WORDHUNT_MAX_SIDE || seed->cols < 1 || seed->cols > WORDHUNT_MAX_SIDE || seed->time_seconds > 9999
+        || seed->blanks > 9 || seed->layout >= BoardLayout_COUNT || seed->generator >= SeedGenerator_COUNT)
+    {
+        return -1;
+    }
+    const int tile_count = seed->rows * seed->cols;
+    const bool all_active = seed->ActiveCount() == tile_count;
+    const int mask_size = all_active ? 0 : (tile_count + 7) / 8;
+    if (buffer_size < (size_t)(8 + mask_size))
+    {
+        return -1;
+    }
+    buffer[0] = (unsigned char)((seed->rows - 1) << 4 | (seed->cols - 1));
+    buffer[1] = (unsigned char)(seed->layout | seed->blanks << 3 | (all_active ? 0x80 : 0));
+    for (int i = 0; i < 4; i++)
+    {
+        buffer[2 + i] = (unsigned char)(seed->seed_value >> (8 * i));
+    }
+    buffer[6] = (unsigned char)(seed->time_seconds);
+    buffer[7] = (unsigned char)(seed->time_seconds >> 8 | seed->generator << 6);
+    for (int i = 0; i < mask_size; i++)
+    {
+        buffer[8 + i] = (unsigned char)(seed->board[i >> 2] >> ((i & 3) * 8));
+    }
+    return 8 + mask_size;
+}
+
+// Returns the bytes read, or -1 if 'data' does not start with a valid binary seed. 'out' is only written on success.
+int WordHunt::DecodeSeed(const unsigned char* data, const size_t size, Seed* out)
+{
+    if (size < 8)
+    {
+        return -1;
+    }
+    const int rows = (data[0] >> 4) + 1;
+    const int cols = (data[0] & 15) + 1;
+    const int layout = data[1] & 7;
+    const int blanks = (data[1] >> 3) & 15;
+    const int time_seconds = data[6] | (data[7] & 0x3F) << 8;
+    const int generator = data[7] >> 6;
+    if (rows > WORDHUNT_MAX_SIDE || cols > WORDHUNT_MAX_SIDE || layout >= BoardLayout_COUNT || blanks > 9 || time_seconds > 9999
+        || generator >= SeedGenerator_COUNT)
+    {
+        return -1;
+    }
+
+    const int tile_count = rows * cols;
+    const bool all_active = (data[1] & 0x80) != 0;
+    const int mask_size = all_active ? 0 : (tile_count + 7) / 8;
+    if (size < (size_t)(8 + mask_size))
+    {
+        return -1;
+    }
+    Seed seed(0u);
+    seed.seed_value = (unsigned int)data[2] | (unsigned int)data[3] << 8 | (unsigned int)data[4] << 16 | (unsigned int)data[5] << 24;
+    seed.time_seconds = (unsigned short)time_seconds;
+    seed.blanks = (unsigned char)blanks;
+    seed.layout = (unsigned char)layout;
+    seed.generator = (unsigned char)generator;
+    seed.SetShape(rows, cols, all_active);
+    for (int i = 0; i < mask_size; i++)
+    {
+        seed.board[i >> 2] |= (unsigned int)data[8 + i] << ((i & 3) * 8);
+    }
+    // Padding bits of the last mask byte are not part of the board
+    if (!all_active && (tile_count & 31))
+    {
+        seed.board[tile_count >> 5] &= (1u << (tile_count & 31)) - 1;
+    }
+    if (out)
+    {
+        *out = seed;
+    }
+    return 8 + mask_size;
+}
+
+char* WordHunt::GetTile(char* letters, const int tile_index)
+{
+    return &letters[tile_index * WORDHUNT_TILE_STRIDE];
+}
+
+void WordHunt::Setup(char* file_name)
+{
     SetMinWordLength(3);
     SetMaxPoints(0);
     SetDictAsDefault(AddDictionary(file_name));
@@ -474,75 +1019,1089 @@ static std::set<Solution*>      solution_list;
 static Seed*                    seed;
 */
 
+// Numbers the distinct words of a finished solve, IDs follow sol_list so iterating them in order lists words as sol_list does
+static void IndexSolverWords(Solver* solver, LetterNode* root)
+{
+    solver->words.assign(solver->sol_list.begin(), solver->sol_list.end());
+    solver->word_ids.reserve(solver->words.size());
+    solver->total_points = 0;
+    for (int id = 0; id < (int)solver->words.size(); id++)
+    {
+        Solution* solution = solver->words[id];
+        LetterNode* node = root;
+        for (int i = 0; i < solution->length; i++)
+        {
+            node = node->children[solution->word[i] - 'A'];
+        }
+        solver->word_ids[node] = id;
+        solver->total_points += solution->GetPointValue();
+    }
+}
+
 Solver* WordHunt::SolveCurrentSeed(char* letters)
 {
-    Solver* solver = new Solver(letters, WordHunt::GetCurrentSeed());
-    Seed* _current_seed = WordHunt::GetCurrentSeed();
+    Solver* solver = SessionNew<Solver>(letters, WordHunt::GetCurrentSeed());
+    const int cols = solver->graph.cols;
+    LetterNode* root = GetDefaultDictionary()->head;
+
+    // Without adjacency every ordering of tiles is a path, walk the trie against the rack of tiles instead
+    if (GetCurrentSeed()->layout == BoardLayout_Free)
+    {
+        SolveFreeLetters(solver);
+        IndexSolverWords(solver, root);
+        return solver;
+    }
 
-    for (int i = 0; i < _current_seed->rows; i++)
+    for (int tile_index = 0; tile_index < solver->graph.TileCount(); tile_index++)
     {
-        for (int j = 0; j < _current_seed->cols; j++)
+        if (!solver->graph.active[tile_index])
+        {
+            continue;
+        }
+        if (solver->codes[tile_index].blank)
         {
-            if (!_current_seed->board[i][j])
+            for (unsigned int mask = ExpandBlank(solver, tile_index, root); mask; mask &= mask - 1)
             {
-                continue;
+                int letter = LowestBit(mask);
+                const char tile[2] = { char('A' + letter), 0 };
+                Tile* head = SessionNew<Tile>(tile_index / cols, tile_index % cols, tile);
+                WordHunt::SolveStartHere(solver, tile_index, head, head, root->children[letter], 1);
             }
-            char letter = solver->grid[i][j];
-            Tile* head = new Tile(i, j, letter);
-            WordHunt::SolveStartHere(solver, _current_seed, i, j, head, head, GetDefaultDictionary()->head->children[letter - 'A'], 1);
+            continue;
+        }
+        LetterNode* next_pos = WordHunt::AdvanceTile(root, solver->codes[tile_index]);
+        if (!next_pos)
+        {
+            continue;
         }
+        Tile* head = SessionNew<Tile>(tile_index / cols, tile_index % cols, solver->tiles[tile_index]);
+        WordHunt::SolveStartHere(solver, tile_index, head, head, next_pos, solver->codes[tile_index].length);
     }
+    IndexSolverWords(solver, root);
     return solver;
-}                                                               
+}
 
-void WordHunt::SolveStartHere(Solver* solver, Seed* seed, const int cur_row, const int cur_col, Tile* head, Tile* prev, LetterNode* dictionary_pos, const int depth)
+//-------------------------------------------------------------------------
+// [SECTION] BOARD GRAPHS
+//-------------------------------------------------------------------------
+
+static void BeginGraph(BoardGraph* graph, Seed* seed)
 {
-    solver->visited[cur_row][cur_col] = true;
+    graph->rows = seed->rows;
+    graph->cols = seed->cols;
+    graph->active = std::vector<bool>(seed->rows * seed->cols, false);
+    for (int tile_index = seed->NextActive(-1); tile_index >= 0; tile_index = seed->NextActive(tile_index))
+    {
+        graph->active[tile_index] = true;
+    }
+    graph->offsets.clear();
+    graph->neighbors.clear();
+}
 
-    if (dictionary_pos->end_of_word && depth >= WordHunt::GetMinWordLength())
+// Appends the edge to the tile currently being built, skipping inactive tiles, itself and repeats (small wrapped boards)
+static void AddGraphEdge(BoardGraph* graph, const int tile_index, const int neighbor_index)
+{
+    if (neighbor_index == tile_index || !graph->active[tile_index] || !graph->active[neighbor_index])
     {
-        Tile* new_head = new Tile(head->x, head->y, head->val);
-        Tile* temp = head->next, *new_temp = new_head;
+        return;
+    }
+    for (int i = graph->offsets.back(); i < (int)graph->neighbors.size(); i++)
+    {
+        if (graph->neighbors[i] == neighbor_index)
+        {
+            return;
+        }
+    }
+    graph->neighbors.push_back(neighbor_index);
+}
 
-        while (temp)
+void WordHunt::BuildBoardGraph(BoardGraph* graph, Seed* seed)
+{
+    switch (seed->layout)
+    {
+    case BoardLayout_Hex:   BuildHexGraph(graph, seed); break;
+    case BoardLayout_Torus: BuildSquareGraph(graph, seed, true); break;
+    case BoardLayout_Free:  BuildCompleteGraph(graph, seed); break;
+    default:                BuildSquareGraph(graph, seed, false); break;
+    }
+}
+
+void WordHunt::BuildSquareGraph(BoardGraph* graph, Seed* seed, const bool wrap_around)
+{
+    BeginGraph(graph, seed);
+    for (int row = 0; row < graph->rows; row++)
+    {
+        for (int col = 0; col < graph->cols; col++)
         {
-            new_temp->next = new Tile(temp->x, temp->y, temp->val);
-            new_temp = new_temp->next;
-            temp = temp->next;
+            graph->offsets.push_back((int)graph->neighbors.size());
+            for (int dr = -1; dr <= 1; dr++)
+            {
+                for (int dc = -1; dc <= 1; dc++)
+                {
+                    int new_row = row + dr;
+                    int new_col = col + dc;
+                    if (wrap_around)
+                    {
+                        new_row = (new_row + graph->rows) % graph->rows;
+                        new_col = (new_col + graph->cols) % graph->cols;
+                    }
+                    else if (0 > new_row || new_row >= graph->rows || 0 > new_col || new_col >= graph->cols)
+                    {
+                        continue;
+                    }
+                    AddGraphEdge(graph, row * graph->cols + col, new_row * graph->cols + new_col);
+                }
+            }
+        }
+    }
+    graph->offsets.push_back((int)graph->neighbors.size());
+}
+
+void WordHunt::BuildHexGraph(BoardGraph* graph, Seed* seed)
+{
+    // Offset rows: odd rows are shifted right, so their diagonal neighbors are at col and col + 1
+    static const int even_row_offsets[6][2] = { { 0, -1 }, { 0, 1 }, { -1, -1 }, { -1, 0 }, { 1, -1 }, { 1, 0 } };
+    static const int odd_row_offsets[6][2] =  { { 0, -1 }, { 0, 1 }, { -1, 0 },  { -1, 1 }, { 1, 0 },  { 1, 1 } };
+
+    BeginGraph(graph, seed);
+    for (int row = 0; row < graph->rows; row++)
+    {
+        const int (*row_offsets)[2] = (row % 2) ? odd_row_offsets : even_row_offsets;
+        for (int col = 0; col < graph->cols; col++)
+        {
+            graph->offsets.push_back((int)graph->neighbors.size());
+            for (int i = 0; i < 6; i++)
+            {
+                int new_row = row + row_offsets[i][0];
+                int new_col = col + row_offsets[i][1];
+                if (0 > new_row || new_row >= graph->rows || 0 > new_col || new_col >= graph->cols)
+                {
+                    continue;
+                }
+                AddGraphEdge(graph, row * graph->cols + col, new_row * graph->cols + new_col);
+            }
+        }
+    }
+    graph->offsets.push_back((int)graph->neighbors.size());
+}
+
+// Every active tile neighbors every other one, used by BoardLayout_Free for selection
+void WordHunt::BuildCompleteGraph(BoardGraph* graph, Seed* seed)
+{
+    BeginGraph(graph, seed);
+    for (int tile_index = 0; tile_index < graph->TileCount(); tile_index++)
+    {
+        graph->offsets.push_back((int)graph->neighbors.size());
+        for (int neighbor_index = 0; neighbor_index < graph->TileCount(); neighbor_index++)
+        {
+            if (neighbor_index != tile_index && graph->active[tile_index] && graph->active[neighbor_index])
+            {
+                graph->neighbors.push_back(neighbor_index);
+            }
         }
+    }
+    graph->offsets.push_back((int)graph->neighbors.size());
+}
 
-        solver->sol_list.insert(new Solution(new_head));
+// Arbitrary layouts: 'edges' holds edge_count undirected (a, b) tile index pairs, every tile is active
+void WordHunt::BuildCustomGraph(BoardGraph* graph, const int rows, const int cols, const int* edges, const int edge_count)
+{
+    graph->rows = rows;
+    graph->cols = cols;
+    graph->active = std::vector<bool>(rows * cols, true);
+
+    std::vector<int> degree(rows * cols + 1, 0);
+    for (int i = 0; i < edge_count; i++)
+    {
+        degree[edges[i * 2]]++;
+        degree[edges[i * 2 + 1]]++;
+    }
+    graph->offsets = std::vector<int>(rows * cols + 1, 0);
+    for (int tile_index = 0; tile_index < rows * cols; tile_index++)
+    {
+        graph->offsets[tile_index + 1] = graph->offsets[tile_index] + degree[tile_index];
+    }
+    graph->neighbors = std::vector<int>(graph->offsets.back());
+    std::vector<int> fill(graph->offsets.begin(), graph->offsets.end() - 1);
+    for (int i = 0; i < edge_count; i++)
+    {
+        graph->neighbors[fill[edges[i * 2]]++] = edges[i * 2 + 1];
+        graph->neighbors[fill[edges[i * 2 + 1]]++] = edges[i * 2];
+    }
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] FREE LETTER SOLVER
+//-------------------------------------------------------------------------
+
+// A rack of unplaced tiles, walked through the trie one whole tile at a time as on a grid, so a "TH" tile only
+// ever spells TH. One-letter tiles are counted per letter, longer tiles with the same string are one kind.
+// A tile is identified by its 'piece': the letter of a one-letter tile, or 26 + kind.
+struct FreeTileSearch
+{
+    int                         single_counts[26];  // One-letter tiles left of each letter
+    TileCode                    kinds[WORDHUNT_MAX_SIDE * WORDHUNT_MAX_SIDE];
+    int                         kind_counts[WORDHUNT_MAX_SIDE * WORDHUNT_MAX_SIDE];
+    int                         next_kinds[WORDHUNT_MAX_SIDE * WORDHUNT_MAX_SIDE]; // Next kind with the same first letter, or -1
+    int                         first_kinds[26];    // First kind starting with each letter, or -1
+    int                         kind_count;
+    int                         letter_counts[26];  // Letters left across all tiles
+    unsigned int                rack_mask;          // Letters with a non-zero count
+    int                         blanks;
+    int                         remaining;          // Letters + blanks left
+    int                         path[32];           // Piece taken for each tile, -1 - letter for a blank
+    void                        (*on_word)(FreeTileSearch* search, const LetterNode* node, int length, int tiles);
+    void*                       user_data;
+
+    FreeTileSearch()
+    {
+        memset(single_counts, 0, sizeof(single_counts));
+        memset(first_kinds, -1, sizeof(first_kinds));
+        memset(letter_counts, 0, sizeof(letter_counts));
+        kind_count = 0;
+        rack_mask = 0;
+        blanks = remaining = 0;
+        on_word = NULL;
+        user_data = NULL;
     }
 
-    static const int r_size = sizeof(solver->dr) / sizeof(solver->dr[0]);
-    static const int c_size = sizeof(solver->dc) / sizeof(solver->dc[0]);
-    for (int i = 0; i < r_size; i++)
+    // Returns the piece the tile was counted as, -1 for blanks and empty tiles
+    int AddTile(const TileCode& code)
     {
-        for (int j = 0; j < c_size; j++)
+        if (code.blank)
         {
-            int new_row = cur_row + solver->dr[i];
-            int new_col = cur_col + solver->dc[j];
-            if (new_row == cur_row && new_col == cur_col)
+            blanks++;
+            remaining++;
+            return -1;
+        }
+        if (code.length == 0)
+        {
+            return -1;
+        }
+        for (int i = 0; i < code.length; i++)
+        {
+            letter_counts[code.index[i]]++;
+            rack_mask |= 1u << code.index[i];
+        }
+        remaining += code.length;
+        if (code.length == 1)
+        {
+            single_counts[code.index[0]]++;
+            return code.index[0];
+        }
+
+        int kind = 0;
+        while (kind < kind_count && (kinds[kind].length != code.length || memcmp(kinds[kind].index, code.index, code.length) != 0))
+        {
+            kind++;
+        }
+        if (kind == kind_count)
+        {
+            kinds[kind] = code;
+            kind_counts[kind] = 0;
+            next_kinds[kind] = first_kinds[code.index[0]];
+            first_kinds[code.index[0]] = kind;
+            kind_count++;
+        }
+        kind_counts[kind]++;
+        return 26 + kind;
+    }
+
+    // First letters of the pieces left, blanks aside
+    unsigned int FirstMask() const
+    {
+        unsigned int mask = 0;
+        for (int letter = 0; letter < 26; letter++)
+        {
+            mask |= single_counts[letter] ? 1u << letter : 0;
+        }
+        for (int kind = 0; kind < kind_count; kind++)
+        {
+            mask |= kind_counts[kind] ? 1u << kinds[kind].index[0] : 0;
+        }
+        return mask;
+    }
+
+    void TakeKind(const int kind)
+    {
+        const TileCode& code = kinds[kind];
+        for (int i = 0; i < code.length; i++)
+        {
+            if (--letter_counts[code.index[i]] == 0)
             {
-                continue;
+                rack_mask &= ~(1u << code.index[i]);
             }
-            if (0 > new_row || new_row >= seed->rows || 0 > new_col || new_col >= seed->cols || !seed->board[new_row][new_col])
+        }
+        remaining -= code.length;
+        kind_counts[kind]--;
+    }
+
+    void ReturnKind(const int kind)
+    {
+        const TileCode& code = kinds[kind];
+        for (int i = 0; i < code.length; i++)
+        {
+            letter_counts[code.index[i]]++;
+            rack_mask |= 1u << code.index[i];
+        }
+        remaining += code.length;
+        kind_counts[kind]++;
+    }
+
+    // Prunes on what the subtree of 'node' would still need once the kind is taken
+    bool CanCompleteWithout(const LetterNode* node, const int kind) const
+    {
+        const TileCode& code = kinds[kind];
+        unsigned int mask = rack_mask;
+        for (int i = 0; i < code.length; i++)
+        {
+            int uses = 0;
+            for (int j = 0; j < code.length; j++)
+            {
+                uses += code.index[j] == code.index[i] ? 1 : 0;
+            }
+            if (letter_counts[code.index[i]] == uses)
+            {
+                mask &= ~(1u << code.index[i]);
+            }
+        }
+        return node->min_remaining <= remaining - code.length && WordHunt::BitCount(node->required_mask & ~mask) <= blanks;
+    }
+};
+
+static void SolveFreeTilesHere(FreeTileSearch* search, LetterNode* node, const int length, const int tiles, const unsigned int first_mask)
+{
+    if (node->end_of_word && length >= WordHunt::GetMinWordLength())
+    {
+        search->on_word(search, node, length, tiles);
+    }
+    if (tiles + 1 > (int)(sizeof(search->path) / sizeof(search->path[0])))
+    {
+        return;
+    }
+
+    // Blanks may take any child letter, otherwise only letters a tile left in the rack starts with
+    unsigned int candidates = node->child_mask & (search->blanks ? ~0u : first_mask);
+    for (; candidates; candidates &= candidates - 1)
+    {
+        const int letter = WordHunt::LowestBit(candidates);
+        for (int kind = search->first_kinds[letter]; kind != -1; kind = search->next_kinds[kind])
+        {
+            if (!search->kind_counts[kind])
             {
                 continue;
             }
-            if (solver->visited[new_row][new_col])
+            LetterNode* child = WordHunt::AdvanceTile(node, search->kinds[kind]);
+            if (!child || !search->CanCompleteWithout(child, kind))
             {
                 continue;
             }
+            search->TakeKind(kind);
+            search->path[tiles] = 26 + kind;
+            SolveFreeTilesHere(search, child, length + search->kinds[kind].length, tiles + 1, search->kind_count ? search->FirstMask() : first_mask);
+            search->ReturnKind(kind);
+        }
+
+        // A one-letter tile, or a blank when none is left: a blank standing in for a letter whose own tile is
+        // still unused spells nothing that tile would not
+        LetterNode* child = node->children[letter];
+        const bool use_blank = search->single_counts[letter] == 0;
+        if (use_blank && !search->blanks)
+        {
+            continue;
+        }
+        unsigned int rack_mask = search->rack_mask;
+        int blanks = search->blanks;
+        if (use_blank)
+        {
+            blanks--;
+        }
+        else if (search->letter_counts[letter] == 1)
+        {
+            rack_mask &= ~(1u << letter);
+        }
+        if (child->min_remaining > search->remaining - 1)
+        {
+            continue;
+        }
+        if (WordHunt::BitCount(child->required_mask & ~rack_mask) > blanks)
+        {
+            continue;
+        }
 
-            char letter = solver->grid[new_row][new_col];
-            if (dictionary_pos->hasChildren && dictionary_pos->isChild[letter - 'A'])
+        const unsigned int saved_rack_mask = search->rack_mask;
+        const int saved_blanks = search->blanks;
+        unsigned int next_first_mask = first_mask;
+        if (!use_blank)
+        {
+            search->letter_counts[letter]--;
+            if (--search->single_counts[letter] == 0)
             {
-                prev->next = new Tile(new_row, new_col, letter);
-                WordHunt::SolveStartHere(solver, seed, new_row, new_col, head, prev->next, dictionary_pos->children[letter - 'A'], depth + 1);
+                next_first_mask = search->kind_count ? search->FirstMask() : first_mask & ~(1u << letter);
             }
         }
+        search->rack_mask = rack_mask;
+        search->blanks = blanks;
+        search->remaining--;
+        search->path[tiles] = use_blank ? -1 - letter : letter;
+
+        SolveFreeTilesHere(search, child, length + 1, tiles + 1, next_first_mask);
+
+        search->remaining++;
+        search->blanks = saved_blanks;
+        search->rack_mask = saved_rack_mask;
+        if (!use_blank)
+        {
+            search->letter_counts[letter]++;
+            search->single_counts[letter]++;
+        }
+    }
+}
+
+static void SolveFreeTiles(FreeTileSearch* search, LetterNode* root)
+{
+    SolveFreeTilesHere(search, root, 0, 0, search->FirstMask());
+}
+
+static void AddLetterCountWord(FreeTileSearch* search, const LetterNode*, int, const int tiles)
+{
+    char word[sizeof(search->path) / sizeof(search->path[0])];
+    for (int i = 0; i < tiles; i++)
+    {
+        word[i] = char('A' + (search->path[i] < 0 ? -1 - search->path[i] : search->path[i]));
+    }
+    ((std::vector<std::string>*)search->user_data)->push_back(std::string(word, word + tiles));
+}
+
+// Every dictionary word spelled by at most letter_counts[i] of each letter plus 'blanks' wildcards
+void WordHunt::SolveLetterCounts(Dictionary* dictionary, const int letter_counts[26], const int blanks, std::vector<std::string>& words)
+{
+    FreeTileSearch search;
+    for (int letter = 0; letter < 26; letter++)
+    {
+        const char tile[2] = { char('A' + letter), 0 };
+        for (int i = 0; i < letter_counts[letter]; i++)
+        {
+            search.AddTile(TileCode(tile));
+        }
+    }
+    const char blank[2] = { WORDHUNT_BLANK, 0 };
+    for (int i = 0; i < blanks; i++)
+    {
+        search.AddTile(TileCode(blank));
+    }
+    search.on_word = AddLetterCountWord;
+    search.user_data = &words;
+    SolveFreeTiles(&search, dictionary->head);
+}
+
+struct FreeTileSolve
+{
+    Solver*                     solver;
+    std::vector<std::vector<int> > piece_tiles; // Tile indices of each piece
+    std::vector<int>            blank_tiles;
+    std::set<const LetterNode*> found;
+};
+
+// Lays the path of a new word onto tiles, the i-th use of a piece takes its i-th tile
+static void AddFreeTileWord(FreeTileSearch* search, const LetterNode* node, int, const int tiles)
+{
+    FreeTileSolve* solve = (FreeTileSolve*)search->user_data;
+    if (!solve->found.insert(node).second)
+    {
+        return;
+    }
+
+    Solver* solver = solve->solver;
+    const int cols = solver->graph.cols;
+    int piece_used[26 + WORDHUNT_MAX_SIDE * WORDHUNT_MAX_SIDE] = { 0 };
+    int blanks_used = 0;
+    Tile* head = NULL;
+    Tile* last = NULL;
+    for (int i = 0; i < tiles; i++)
+    {
+        const int piece = search->path[i];
+        Tile* next;
+        if (piece < 0)
+        {
+            const int tile_index = solve->blank_tiles[blanks_used++];
+            const char tile[2] = { char('A' - 1 - piece), 0 };
+            next = WordHunt::SessionNew<Tile>(tile_index / cols, tile_index % cols, tile);
+        }
+        else
+        {
+            const int tile_index = solve->piece_tiles[piece][piece_used[piece]++];
+            next = WordHunt::SessionNew<Tile>(tile_index / cols, tile_index % cols, solver->tiles[tile_index]);
+        }
+        if (last)
+        {
+            last->next = next;
+        }
+        else
+        {
+            head = next;
+        }
+        last = next;
+    }
+    solver->sol_list.insert(WordHunt::SessionNew<Solution>(head));
+}
+
+void WordHunt::SolveFreeLetters(Solver* solver)
+{
+    FreeTileSearch search;
+    FreeTileSolve solve;
+    solve.solver = solver;
+    for (int tile_index = 0; tile_index < solver->graph.TileCount(); tile_index++)
+    {
+        if (!solver->graph.active[tile_index])
+        {
+            continue;
+        }
+        const int piece = search.AddTile(solver->codes[tile_index]);
+        if (piece >= 0)
+        {
+            solve.piece_tiles.resize(26 + search.kind_count);
+            solve.piece_tiles[piece].push_back(tile_index);
+        }
+        else if (solver->codes[tile_index].blank)
+        {
+            solve.blank_tiles.push_back(tile_index);
+        }
+    }
+    search.on_word = AddFreeTileWord;
+    search.user_data = &solve;
+    SolveFreeTiles(&search, GetDefaultDictionary()->head);
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] SCORE-ONLY SOLVER
+//-------------------------------------------------------------------------
+
+// Reusable state of a score-only solve over one board shape. Words are deduplicated by their terminal
+// trie node in an open-addressed set; a generation stamp clears it between boards without a memset.
+struct BoardScorer
+{
+    const BoardGraph*           graph;
+    int                         layout;
+    std::vector<TileCode>       codes;
+    std::vector<char>           visited;
+    std::vector<const LetterNode*> found;
+    std::vector<unsigned int>   found_stamp;
+    unsigned int                stamp;
+    int                         found_count;
+    BoardScore                  score;
+
+    BoardScorer()
+    {
+        graph = NULL;
+        layout = BoardLayout_Square;
+        found = std::vector<const LetterNode*>(1024);
+        found_stamp = std::vector<unsigned int>(1024, 0);
+        stamp = 0;
+        found_count = 0;
+    }
+
+    // Points the scorer at a board shape, the found-word table keeps the size it grew to
+    void Bind(const BoardGraph* _graph, Seed* seed)
+    {
+        graph = _graph;
+        layout = seed->layout;
+        codes.resize(graph->TileCount());
+        visited.assign(graph->TileCount(), 0);
+    }
+
+    void Reset()
+    {
+        score = BoardScore();
+        found_count = 0;
+        if (++stamp == 0)
+        {
+            std::fill(found_stamp.begin(), found_stamp.end(), 0);
+            stamp = 1;
+        }
+    }
+
+    // Returns false if the word was already counted
+    bool Insert(const LetterNode* node)
+    {
+        if ((found_count + 1) * 2 > (int)found.size())
+        {
+            Grow();
+        }
+        size_t mask = found.size() - 1;
+        size_t slot = ((size_t)node >> 4) * 0x9E3779B97F4A7C15ull & mask;
+        while (found_stamp[slot] == stamp)
+        {
+            if (found[slot] == node)
+            {
+                return false;
+            }
+            slot = (slot + 1) & mask;
+        }
+        found[slot] = node;
+        found_stamp[slot] = stamp;
+        found_count++;
+        return true;
+    }
+
+    void Grow()
+    {
+        std::vector<const LetterNode*> old_found;
+        old_found.swap(found);
+        std::vector<unsigned int> old_stamp;
+        old_stamp.swap(found_stamp);
+        found = std::vector<const LetterNode*>(old_found.size() * 2);
+        found_stamp = std::vector<unsigned int>(old_found.size() * 2, 0);
+        found_count = 0;
+        for (size_t i = 0; i < old_found.size(); i++)
+        {
+            if (old_stamp[i] == stamp)
+            {
+                Insert(old_found[i]);
+            }
+        }
+    }
+
+    void AddWord(const LetterNode* node, const int length)
+    {
+        if (length >= WordHunt::GetMinWordLength() && Insert(node))
+        {
+            score.words++;
+            score.points += WordHunt::GetPointVal(length);
+            score.longest = length > score.longest ? length : score.longest;
+        }
+    }
+};
+
+static void ScoreFrom(BoardScorer* scorer, const int tile_index, LetterNode* dictionary_pos, const int depth)
+{
+    if (dictionary_pos->end_of_word)
+    {
+        scorer->AddWord(dictionary_pos, depth);
+    }
+    if (!dictionary_pos->child_mask)
+    {
+        return;
+    }
+
+    scorer->visited[tile_index] = true;
+    const BoardGraph& graph = *scorer->graph;
+    for (int i = graph.offsets[tile_index]; i < graph.offsets[tile_index + 1]; i++)
+    {
+        const int next_index = graph.neighbors[i];
+        if (scorer->visited[next_index])
+        {
+            continue;
+        }
+        const TileCode& code = scorer->codes[next_index];
+        if (code.blank)
+        {
+            for (unsigned int mask = dictionary_pos->child_mask; mask; mask &= mask - 1)
+            {
+                ScoreFrom(scorer, next_index, dictionary_pos->children[WordHunt::LowestBit(mask)], depth + 1);
+            }
+            continue;
+        }
+        LetterNode* next_pos = WordHunt::AdvanceTile(dictionary_pos, code);
+        if (next_pos)
+        {
+            ScoreFrom(scorer, next_index, next_pos, depth + code.length);
+        }
+    }
+    scorer->visited[tile_index] = false;
+}
+
+static void AddScoredFreeWord(FreeTileSearch* search, const LetterNode* node, const int length, int)
+{
+    ((BoardScorer*)search->user_data)->AddWord(node, length);
+}
+
+static void ScoreCandidate(BoardScorer* scorer, char* letters, BoardScore* out)
+{
+    scorer->Reset();
+    LetterNode* root = WordHunt::GetDefaultDictionary()->head;
+    const BoardGraph& graph = *scorer->graph;
+    for (int tile_index = 0; tile_index < graph.TileCount(); tile_index++)
+    {
+        scorer->codes[tile_index] = TileCode(WordHunt::GetTile(letters, tile_index));
+    }
+
+    // The same tile walk as SolveFreeLetters, a word spelled by several tile orders counts once
+    if (scorer->layout == BoardLayout_Free)
+    {
+        FreeTileSearch search;
+        for (int tile_index = 0; tile_index < graph.TileCount(); tile_index++)
+        {
+            if (graph.active[tile_index])
+            {
+                search.AddTile(scorer->codes[tile_index]);
+            }
+        }
+        search.on_word = AddScoredFreeWord;
+        search.user_data = scorer;
+        SolveFreeTiles(&search, root);
+        *out = scorer->score;
+        return;
+    }
+
+    for (int tile_index = 0; tile_index < graph.TileCount(); tile_index++)
+    {
+        const TileCode& code = scorer->codes[tile_index];
+        if (!graph.active[tile_index])
+        {
+            continue;
+        }
+        if (code.blank)
+        {
+            for (unsigned int mask = root->child_mask; mask; mask &= mask - 1)
+            {
+                ScoreFrom(scorer, tile_index, root->children[WordHunt::LowestBit(mask)], 1);
+            }
+            continue;
+        }
+        LetterNode* next_pos = WordHunt::AdvanceTile(root, code);
+        if (next_pos)
+        {
+            ScoreFrom(scorer, tile_index, next_pos, code.length);
+        }
+    }
+    *out = scorer->score;
+}
+
+// Points, word count and longest word of a board without building Solutions
+void WordHunt::ScoreBoard(char* letters, Seed* seed, BoardScore* out)
+{
+    BoardGraph graph;
+    BuildBoardGraph(&graph, seed);
+    BoardScorer scorer;
+    scorer.Bind(&graph, seed);
+    ScoreCandidate(&scorer, letters, out);
+}
+
+// Seed value of the k-th redraw, k = 0 is the seed itself
+static unsigned int CandidateSeedValue(unsigned int seed_value, int k)
+{
+    if (k == 0)
+    {
+        return seed_value;
+    }
+    unsigned int x = seed_value ^ (unsigned int)k * 0x9E3779B9u;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// One scorer per worker, kept across GenerateGame() calls so their found-word tables are not regrown for
+// every board. GenerateGame() with constraints is called from one thread at a time, like the rest of WordHunt.
+static std::vector<BoardScorer> generate_scorers;
+
+// A thread costs about as much to start as scoring a small board, extra workers only pay off with a few
+// attempts each
+static const int                generate_attempts_per_thread = 8;
+
+// Redraws until the board meets 'constraints', scoring candidates in parallel with a score-only solve.
+// The lowest passing redraw wins, so the result does not depend on thread timing, and seed->seed_value is
+// updated to it so the seed string reproduces the board. Returns false if no draw passed within
+// max_attempts, leaving the highest scoring one.
+bool WordHunt::GenerateGame(char* s, const size_t len, Seed* seed, const BoardConstraints& constraints)
+{
+    const int max_attempts = constraints.max_attempts > 0 ? constraints.max_attempts : 1;
+    const int tile_count = seed->rows * seed->cols;
+    std::vector<BoardScore> scores(max_attempts);
+    std::atomic<int> next_attempt(0);
+    std::atomic<int> first_passing(max_attempts);
+
+    BoardGraph graph;
+    BuildBoardGraph(&graph, seed);
+
+    int thread_count = (int)std::thread::hardware_concurrency();
+    thread_count = thread_count > max_attempts / generate_attempts_per_thread ? max_attempts / generate_attempts_per_thread : thread_count;
+    thread_count = thread_count < 1 ? 1 : thread_count;
+    if ((int)generate_scorers.size() < thread_count)
+    {
+        generate_scorers.resize(thread_count);
+    }
+    for (int i = 0; i < thread_count; i++)
+    {
+        generate_scorers[i].Bind(&graph, seed);
+    }
+
+    auto worker = [&](BoardScorer* scorer)
+    {
+        std::vector<char> letters(tile_count * WORDHUNT_TILE_STRIDE + 1);
+        Seed candidate = *seed;
+        for (int k = next_attempt++; k < first_passing.load(); k = next_attempt++)
+        {
+            candidate.seed_value = CandidateSeedValue(seed->seed_value, k);
+            GenerateGame(letters.data(), tile_count, &candidate);
+            ScoreCandidate(scorer, letters.data(), &scores[k]);
+            if (constraints.IsMetBy(scores[k]))
+            {
+                int current = first_passing.load();
+                while (k < current && !first_passing.compare_exchange_weak(current, k)) {}
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < thread_count; i++)
+    {
+        threads.push_back(std::thread(worker, &generate_scorers[i]));
+    }
+    worker(&generate_scorers[0]);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    int chosen = first_passing.load();
+    const bool passed = chosen < max_attempts;
+    if (!passed)
+    {
+        chosen = 0;
+        for (int k = 1; k < max_attempts; k++)
+        {
+            if (scores[k].points > scores[chosen].points)
+            {
+                chosen = k;
+            }
+        }
+    }
+    seed->seed_value = CandidateSeedValue(seed->seed_value, chosen);
+    GenerateGame(s, len, seed);
+    return passed;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] PUZZLE LIBRARY
+//-------------------------------------------------------------------------
+
+bool PuzzleLibrary::Open(const char* file_name)
+{
+    Close();
+    const void* view = NULL;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(file_name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+    {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    if (mapping)
+    {
+        view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (!view)
+    {
+        if (mapping)
+        {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    file_handle = file;
+    mapping_handle = mapping;
+    size = (size_t)file_size.QuadPart;
+#else
+    int file = open(file_name, O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+    struct stat file_stat;
+    if (fstat(file, &file_stat) == 0 && file_stat.st_size > 0)
+    {
+        view = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_SHARED, file, 0);
+    }
+    close(file);
+    if (!view || view == MAP_FAILED)
+    {
+        return false;
+    }
+    size = (size_t)file_stat.st_size;
+#endif
+    header = (const PuzzleLibraryHeader*)view;
+
+    // Everything the lookups touch must lie inside the file
+    const bool valid = size >= sizeof(PuzzleLibraryHeader)
+        && header->magic == WORDHUNT_LIBRARY_MAGIC
+        && header->version == WORDHUNT_LIBRARY_VERSION
+        && header->record_size == sizeof(PuzzleRecord) + header->tile_count * WORDHUNT_TILE_STRIDE
+        && header->records_offset >= sizeof(PuzzleLibraryHeader)
+        && (unsigned long long)header->records_offset + (unsigned long long)header->record_count * header->record_size <= size
+        && (unsigned long long)header->index_offset + (unsigned long long)header->record_count * sizeof(unsigned int) <= size
+        && header->difficulty_start[0] == 0
+        && header->difficulty_start[PuzzleDifficulty_COUNT] == header->record_count
+        && memchr(header->seed, 0, sizeof(header->seed)) != NULL;
+    if (!valid)
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void PuzzleLibrary::Close()
+{
+    if (!header)
+    {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(header);
+    CloseHandle((HANDLE)mapping_handle);
+    CloseHandle((HANDLE)file_handle);
+#else
+    munmap((void*)header, size);
+#endif
+    header = NULL;
+    size = 0;
+    file_handle = mapping_handle = NULL;
+}
+
+int PuzzleLibrary::Count(int difficulty) const
+{
+    if (!header || difficulty < 0 || difficulty >= PuzzleDifficulty_COUNT)
+    {
+        return 0;
+    }
+    return (int)(header->difficulty_start[difficulty + 1] - header->difficulty_start[difficulty]);
+}
+
+const PuzzleRecord* PuzzleLibrary::Get(int difficulty, int n) const
+{
+    if (n < 0 || n >= Count(difficulty))
+    {
+        return NULL;
+    }
+    const unsigned int* index = (const unsigned int*)((const char*)header + header->index_offset);
+    const unsigned int record = index[header->difficulty_start[difficulty] + n];
+    if (record >= header->record_count)
+    {
+        return NULL;
+    }
+    return (const PuzzleRecord*)((const char*)header + header->records_offset + (size_t)record * header->record_size);
+}
+
+const PuzzleRecord* PuzzleLibrary::Daily(int difficulty, unsigned int day) const
+{
+    const int count = Count(difficulty);
+    if (count == 0)
+    {
+        return NULL;
+    }
+    // Scatter consecutive days over the whole class instead of walking it in score order
+    unsigned int x = day * 0x9E3779B9u;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    return Get(difficulty, (int)(x % (unsigned int)count));
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] SOLVER INTERNALS
+//-------------------------------------------------------------------------
+
+// Consumes every letter of a tile from 'node', returns nullptr when the tile leaves the trie.
+// The tile is pre-translated to child indices, so this is one child load per letter: a single letter tile is already
+// one transition, and a (tile, node) memo like blank_memo costs a hash lookup per step for QU/TH/ER, more than the two
+// loads it saves.
+LetterNode* WordHunt::AdvanceTile(LetterNode* node, const TileCode& code)
+{
+    for (int i = 0; i < code.length; i++)
+    {
+        if (!node->hasChildren || !node->isChild[code.index[i]])
+        {
+            return nullptr;
+        }
+        node = node->children[code.index[i]];
+    }
+    return code.length ? node : nullptr;
+}
+
+// Letters a blank tile may take after 'dictionary_pos': only existing children that end a word or can
+// continue into one of the tile's neighbors. Memoized per (tile, node) since both are fixed for a board.
+unsigned int WordHunt::ExpandBlank(Solver* solver, const int tile_index, LetterNode* dictionary_pos)
+{
+    std::unordered_map<const LetterNode*, unsigned int>& memo = solver->blank_memo[tile_index];
+    auto found = memo.find(dictionary_pos);
+    if (found != memo.end())
+    {
+        return found->second;
+    }
+
+    unsigned int viable = 0;
+    for (unsigned int mask = dictionary_pos->child_mask; mask; mask &= mask - 1)
+    {
+        int letter = LowestBit(mask);
+        LetterNode* child = dictionary_pos->children[letter];
+        if (child->end_of_word || (child->child_mask & solver->neighbor_mask[tile_index]))
+        {
+            viable |= 1u << letter;
+        }
+    }
+    memo[dictionary_pos] = viable;
+    return viable;
+}
+
+void WordHunt::SolveStartHere(Solver* solver, const int tile_index, Tile* head, Tile* prev, LetterNode* dictionary_pos, const int depth)
+{
+    solver->visited[tile_index] = true;
+
+    if (dictionary_pos->end_of_word && depth >= WordHunt::GetMinWordLength())
+    {
+        Tile* new_head = WordHunt::SessionNew<Tile>(head->x, head->y, head->val);
+        Tile* temp = head->next, *new_temp = new_head;
+
+        while (temp)
+        {
+            new_temp->next = WordHunt::SessionNew<Tile>(temp->x, temp->y, temp->val);
+            new_temp = new_temp->next;
+            temp = temp->next;
+        }
+
+        solver->sol_list.insert(WordHunt::SessionNew<Solution>(new_head));
+    }
+
+    const BoardGraph& graph = solver->graph;
+    const int* neighbor = graph.neighbors.data() + graph.offsets[tile_index];
+    const int* neighbor_end = graph.neighbors.data() + graph.offsets[tile_index + 1];
+    for (; neighbor != neighbor_end; neighbor++)
+    {
+        const int next_index = *neighbor;
+        if (solver->visited[next_index])
+        {
+            continue;
+        }
+
+        const TileCode& code = solver->codes[next_index];
+        if (code.blank)
+        {
+            for (unsigned int mask = WordHunt::ExpandBlank(solver, next_index, dictionary_pos); mask; mask &= mask - 1)
+            {
+                int letter = WordHunt::LowestBit(mask);
+                const char tile[2] = { char('A' + letter), 0 };
+                prev->next = WordHunt::SessionNew<Tile>(next_index / graph.cols, next_index % graph.cols, tile);
+                WordHunt::SolveStartHere(solver, next_index, head, prev->next, dictionary_pos->children[letter], depth + 1);
+            }
+            continue;
+        }
+        LetterNode* next_pos = WordHunt::AdvanceTile(dictionary_pos, code);
+        if (next_pos)
+        {
+            prev->next = WordHunt::SessionNew<Tile>(next_index / graph.cols, next_index % graph.cols, solver->tiles[next_index]);
+            WordHunt::SolveStartHere(solver, next_index, head, prev->next, next_pos, depth + code.length);
+        }
     }
 
-    solver->visited[cur_row][cur_col] = false;
+    solver->visited[tile_index] = false;
 }
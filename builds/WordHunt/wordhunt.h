@@ -1,26 +1,92 @@
 #pragma once
 
+#include <cstddef>
+#include <cstring>
 #include <fstream>
+#include <new>
 #include <queue>
 #include <set>
 #include <iostream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 struct LetterNode;
 struct Dictionary;
+struct TrieCursor;
 struct Solution;
 struct Tile;
 struct Seed;
 struct SolutionPointerComparator;
 struct Solver;
+struct TileCode;
+struct BoardGraph;
+struct BoardScore;
+struct BoardConstraints;
+struct PuzzleLibrary;
+struct SessionArena;
+
+// Tiles hold 1 to WORDHUNT_MAX_TILE_LEN letters (e.g. "A", "QU", "TH", "ER").
+// Letter buffers store one NUL-terminated tile string every WORDHUNT_TILE_STRIDE bytes.
+#define WORDHUNT_MAX_TILE_LEN       3
+#define WORDHUNT_TILE_STRIDE        (WORDHUNT_MAX_TILE_LEN + 1)
+
+// A blank tile stands for any single letter, it is stored as the tile string "?"
+#define WORDHUNT_BLANK              '?'
+
+// Seeds describe boards of up to WORDHUNT_MAX_SIDE x WORDHUNT_MAX_SIDE tiles
+#define WORDHUNT_MAX_SIDE           15
+#define WORDHUNT_SEED_BOARD_WORDS   ((WORDHUNT_MAX_SIDE * WORDHUNT_MAX_SIDE + 31) / 32)
+
+// Buffer sizes that always hold a seed, as text (with the NUL) and in binary
+#define WORDHUNT_SEED_TEXT_MAX      256
+#define WORDHUNT_SEED_BINARY_MAX    (8 + (15 * 15 + 7) / 8)
 
 enum WordHuntGamePhase_
 {
     WordHuntGamePhase_Selection     = 0,
     WordHuntGamePhase_Generate      = 1,
-    WordHuntGamePhase_Play          = 2,
-    WordHuntGamePhase_Result        = 3,
+    WordHuntGamePhase_Solve         = 2,    // The board is solved on a worker thread, play starts when it is done
+    WordHuntGamePhase_Play          = 3,
+    WordHuntGamePhase_Result        = 4,
+};
+
+enum BoardLayout_
+{
+    BoardLayout_Square              = 0,    // 8 neighbors
+    BoardLayout_Hex                 = 1,    // 6 neighbors, odd rows sit half a tile to the right
+    BoardLayout_Torus               = 2,    // 8 neighbors, edges wrap around
+    BoardLayout_Free                = 3,    // No adjacency, any tiles combine (anagram round)
+    BoardLayout_COUNT
+};
+
+// How GenerateGame turns a seed value into tiles, recorded in the seed so boards shared before a change stay the same
+enum SeedGenerator_
+{
+    SeedGenerator_MT19937           = 0,    // std::mt19937 + std::uniform_int_distribution over the original 98 single letters, picks differ between standard libraries
+    SeedGenerator_PCG32             = 1,    // PCG32 (XSH RR) + Lemire's bounded sampling over the tile set with QU, TH and ER, the same board everywhere
+    SeedGenerator_COUNT,
+    SeedGenerator_Latest            = SeedGenerator_COUNT - 1
 };
 
+// Classes of a puzzle library, by points on the board: easy boards hide the most words
+enum PuzzleDifficulty_
+{
+    PuzzleDifficulty_Easy           = 0,
+    PuzzleDifficulty_Medium         = 1,
+    PuzzleDifficulty_Hard           = 2,
+    PuzzleDifficulty_COUNT
+};
+
+// Puzzle library file: a PuzzleLibraryHeader, record_count records of record_size bytes, then record_count
+// record numbers sorted by difficulty and, within one difficulty, by points from highest to lowest.
+#define WORDHUNT_LIBRARY_MAGIC      0x424C4857u // "WHLB"
+#define WORDHUNT_LIBRARY_VERSION    1
+
 namespace WordHunt
 {
     // Variable Getters and Setters
@@ -34,17 +100,62 @@ namespace WordHunt
     std::vector<Dictionary*>        GetDictionaries();
     void                            SetCurrentSeed(Seed* _seed);
     Seed*                           GetCurrentSeed();
+    void                            SetSessionArena(SessionArena* _arena);
+    SessionArena*                   GetSessionArena();
 
     // Setup Functions
-    void                            GenerateGame(char* s, const size_t len, int seed);
+    void                            GenerateGame(char* s, const size_t len, int seed, const int generator = SeedGenerator_MT19937);
+    void                            GenerateGame(char* s, const size_t len, Seed* seed);
+    bool                            GenerateGame(char* s, const size_t len, Seed* seed, const BoardConstraints& constraints);
     Dictionary*                     AddDictionary(const char* fileName);
-    int                             IsValidSeed(char* potential_seed);
+    int                             ParseSeed(const char* text, Seed* out);
+    int                             FormatSeed(const Seed* seed, char* buffer, const size_t buffer_size);
+    int                             EncodeSeed(const Seed* seed, unsigned char* buffer, const size_t buffer_size);
+    int                             DecodeSeed(const unsigned char* data, const size_t size, Seed* out);
+    char*                           GetTile(char* letters, const int tile_index);
+    const char* const*              GetTileSet(int* count); // Tiles SeedGenerator_PCG32 draws from, with repeats for frequency
     void                            Setup(char* file_name);
     Solver*                         SolveCurrentSeed(char* letters);
+    void                            SolveLetterCounts(Dictionary* dictionary, const int letter_counts[26], const int blanks, std::vector<std::string>& words);
+    void                            ScoreBoard(char* letters, Seed* seed, BoardScore* out);
+
+    // Board Graphs
+    void                            BuildBoardGraph(BoardGraph* graph, Seed* seed);
+    void                            BuildSquareGraph(BoardGraph* graph, Seed* seed, const bool wrap_around = false);
+    void                            BuildHexGraph(BoardGraph* graph, Seed* seed);
+    void                            BuildCompleteGraph(BoardGraph* graph, Seed* seed);
+    void                            BuildCustomGraph(BoardGraph* graph, const int rows, const int cols, const int* edges, const int edge_count);
 
     // Internals
-    void                            SolveStartHere(Solver* solver, Seed* seed, const int row_i, const int col_i, Tile* head, Tile* last, LetterNode* dictionary_pos, const int depth);
+    void                            SolveStartHere(Solver* solver, const int tile_index, Tile* head, Tile* last, LetterNode* dictionary_pos, const int depth);
+    LetterNode*                     AdvanceTile(LetterNode* node, const TileCode& code);
+    unsigned int                    ExpandBlank(Solver* solver, const int tile_index, LetterNode* dictionary_pos);
+    void                            SolveFreeLetters(Solver* solver);
     void                            WordHuntMenu(bool* p_open);
+    void*                           SessionAlloc(const size_t size, const size_t alignment = alignof(std::max_align_t));
+    template<typename T, typename... Args>
+    T*                              SessionNew(Args&&... args);
+
+    // Index of the lowest set bit, mask must be non-zero
+    inline int                      LowestBit(unsigned int mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (int)index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    inline int                      BitCount(unsigned int mask)
+    {
+#if defined(_MSC_VER)
+        return (int)__popcnt(mask);
+#else
+        return __builtin_popcount(mask);
+#endif
+    }
 }
 
 struct LetterNode
@@ -54,6 +165,9 @@ struct LetterNode
     bool            hasChildren;
     bool*           isChild;
     LetterNode**    children;
+    unsigned int    child_mask; // Bit (letter - 'A') set for every child, iterate with WordHunt::LowestBit
+    unsigned int    required_mask; // Letters every word completed below this node still needs
+    unsigned char   min_remaining; // Fewest letters needed below this node to complete a word
 
     LetterNode(bool _end_of_word, char _letter);
 };
@@ -66,42 +180,95 @@ struct Dictionary
     Dictionary()                    { head = new LetterNode(true, '_'); }
     Dictionary(LetterNode* _head)   { head = _head; }
     void AddWord(char* word, size_t word_length);
-    bool IsWord(const char* word, size_t word_length);
+    void ComputeRequirements(); // Fills required_mask / min_remaining, call again after adding words
+    // WORDHUNT_BLANK matches any letter, 'resolved' (optional, word_length bytes) receives the letters of the first match
+    bool IsWord(const char* word, size_t word_length, char* resolved = NULL);
     bool IsWord(std::string word) { return IsWord(word.data(), word.size()); }
 };
 
+// Follows a tile path through a dictionary one tile at a time, so a drag never walks the trie from the root.
+// Each level holds every node the path can be at: a blank fans out to each child, other tiles advance every node by
+// all their letters. Pop() drops the last tile when the drag retracts.
+struct TrieCursor
+{
+    struct Entry
+    {
+        LetterNode*     node;
+        int             parent;         // Entry of the previous level this one came from, -1 on the first level
+        char            letter;         // Letter a blank stood for, 0 for other tiles
+    };
+    struct Level
+    {
+        int             begin;          // First entry, the level runs to the next level's begin (or the end)
+        int             word_entry;     // First entry ending a word, -1 when none does
+        int             letters;        // Letters in the path up to and including this tile
+        bool            is_prefix;      // Some entry has children, the path can still grow into a word
+        char            tile[WORDHUNT_TILE_STRIDE];
+    };
+
+    Dictionary*         dictionary;
+    std::vector<Entry>  entries;
+    std::vector<Level>  levels;
+
+    TrieCursor()                    { dictionary = NULL; }
+    void Reset(Dictionary* _dictionary);
+    bool Push(const char* tile);    // Returns false when no dictionary word starts with the path any more, the tile is still pushed
+    void Pop();
+    void Clear()                    { entries.clear(); levels.clear(); }
+    int  Depth() const              { return (int)levels.size(); }
+    int  Letters() const            { return levels.empty() ? 0 : levels.back().letters; }
+    bool IsWord() const             { return !levels.empty() && levels.back().word_entry >= 0; }
+    bool IsPrefix() const           { return levels.empty() || levels.back().is_prefix; }
+    const LetterNode* WordNode() const { return IsWord() ? entries[levels.back().word_entry].node : NULL; } // Node ending the word Resolve() writes
+    // Writes the word with blanks resolved as Dictionary::IsWord() would, Letters() + 1 bytes. Returns false unless IsWord().
+    bool Resolve(char* out) const;
+};
+
 struct Tile
 {
     int     x;
     int     y;
-    char    val;
+    char    val[WORDHUNT_TILE_STRIDE];
     Tile*   next;
 
-    Tile(int _x, int _y, char _val)
+    Tile(int _x, int _y, const char* _val)
     {
         x = _x;
         y = _y;
-        val = _val;
+        int i = 0;
+        for (; i < WORDHUNT_MAX_TILE_LEN && _val[i]; i++)
+        {
+            val[i] = _val[i];
+        }
+        val[i] = 0;
         next = NULL;
     }
-    Tile(int _x, int _y, char _val, Tile* _next)
+    Tile(int _x, int _y, const char* _val, Tile* _next) : Tile(_x, _y, _val)
     {
-        x = _x;
-        y = _y;
-        val = _val;
         next = _next;
     }
 };
 
+// Tile string pre-translated to trie child indices, so a whole tile is consumed in one transition
+struct TileCode
+{
+    int             length;
+    unsigned char   index[WORDHUNT_MAX_TILE_LEN];
+    bool            blank;
+
+    TileCode() { length = 0; blank = false; }
+    TileCode(const char* tile);
+};
+
 struct Solution
 {
-    int     length;
+    int     length; // Letters, not tiles: "QU" counts as two
     char*   word;
     Tile*   head;
 
     Solution(Tile* _head);
     int GetPointValue() { return WordHunt::GetPointVal(length); }
-    char* to_string();
+    const char* to_string() const { return word; } // Owned by the solution, do not free
 };
 
 struct SolutionPointerComparator
@@ -115,30 +282,196 @@ struct SolutionPointerComparator
 
 struct Seed
 {
-    int             rows;
-    int             cols;
+    unsigned int    board[WORDHUNT_SEED_BOARD_WORDS]; // Active tiles, bit (tile_index % 32) of word (tile_index / 32), tile_index = row * cols + col
     unsigned int    seed_value;
-    bool            board[15][15];
-    int             time_seconds;
+    unsigned short  time_seconds;
+    unsigned char   rows;
+    unsigned char   cols;
+    unsigned char   blanks;
+    unsigned char   layout;         // BoardLayout_
+    unsigned char   generator;      // SeedGenerator_
 
     // Valid Formats:
-    //      R##C##>1111111111111111[numericalseed]t##
+    //      R##C##>1111111111111111[numericalseed]t##b#g#v#
     //      ^row^col^active squares ^actual srand seed
+    //                                           ^optional blank tile count
+    //                                             ^optional board layout
+    //                                               ^optional generator, SeedGenerator_MT19937 when left out
     //
     //      [numericalseed]
-    //      default row = col = 4, time_seconds = 75
+    //      default row = col = 4, time_seconds = 75, blanks = 0, layout = BoardLayout_Square, generator = SeedGenerator_MT19937
+    // Seed(unsigned int) makes new seeds, those use SeedGenerator_Latest.
+    // Parsed by WordHunt::ParseSeed() and written by WordHunt::FormatSeed(), WordHunt::EncodeSeed() is the binary form
     Seed(unsigned int _seed_value);
-    Seed(char* _complete_seed);
-    char* to_string();
+    Seed(const char* _complete_seed); // Invalid text leaves the defaults of Seed(0)
+    int to_string(char* buffer, const size_t buffer_size) const;
+
+    void    SetShape(int _rows, int _cols, bool active); // Resizes the board with every tile set to 'active'
+    bool    IsActive(int row, int col) const    { return (board[(row * cols + col) >> 5] >> ((row * cols + col) & 31)) & 1; }
+    void    SetActive(int row, int col, bool active);
+    int     ActiveCount() const;
+    int     NextActive(int tile_index) const; // First active tile after 'tile_index', -1 when none. Start from -1.
+    size_t  Hash() const;
+    bool    operator==(const Seed& other) const;
+    bool    operator!=(const Seed& other) const { return !(*this == other); }
+};
+
+// Lets seeds key std::unordered_map / std::unordered_set
+struct SeedHash
+{
+    size_t operator()(const Seed& seed) const { return seed.Hash(); }
+};
+
+// Tile adjacency in compressed sparse row form, tiles are indexed row * cols + col.
+// The neighbors of tile i are neighbors[offsets[i]] .. neighbors[offsets[i + 1] - 1], inactive tiles have none.
+struct BoardGraph
+{
+    int                 rows;
+    int                 cols;
+    std::vector<bool>   active;
+    std::vector<int>    offsets;
+    std::vector<int>    neighbors;
+
+    BoardGraph() { rows = cols = 0; }
+    int  TileCount() const                  { return rows * cols; }
+    bool IsAdjacent(int a, int b) const;
+};
+
+// Totals of a score-only solve, no Solution is allocated
+struct BoardScore
+{
+    int             points;
+    int             words;
+    int             longest;        // Letters in the longest word
+
+    BoardScore() { points = words = longest = 0; }
+};
+
+// What a generated board must offer, see WordHunt::GenerateGame(s, len, seed, constraints)
+struct BoardConstraints
+{
+    int             min_points;
+    int             min_words;
+    int             required_length; // At least one word this long, 0 to ignore
+    int             max_attempts;    // Boards drawn before settling for the highest scoring one
+
+    BoardConstraints() { min_points = 0; min_words = 0; required_length = 0; max_attempts = 256; }
+    bool IsMetBy(const BoardScore& score) const
+    {
+        return score.points >= min_points && score.words >= min_words && score.longest >= required_length;
+    }
+};
+
+struct PuzzleLibraryHeader
+{
+    unsigned int    magic;          // WORDHUNT_LIBRARY_MAGIC
+    unsigned int    version;        // WORDHUNT_LIBRARY_VERSION
+    unsigned int    record_count;
+    unsigned int    record_size;    // sizeof(PuzzleRecord) + tile_count * WORDHUNT_TILE_STRIDE
+    unsigned int    tile_count;     // rows * cols of the seed
+    unsigned int    records_offset;
+    unsigned int    index_offset;
+    unsigned int    difficulty_start[PuzzleDifficulty_COUNT + 1]; // Range of each difficulty in the index
+    char            seed[WORDHUNT_SEED_TEXT_MAX]; // Board shape shared by every record, records only differ by seed value
 };
 
+struct PuzzleRecord
+{
+    unsigned int    seed_value;
+    int             points;
+    unsigned short  words;
+    unsigned char   longest;
+    unsigned char   difficulty;     // PuzzleDifficulty_
+
+    // tile_count tiles follow, laid out like the letters buffer of WordHunt::GenerateGame()
+    const char*     Letters() const { return (const char*)(this + 1); }
+};
+
+// Read-only view of a memory mapped puzzle library
+struct PuzzleLibrary
+{
+    const PuzzleLibraryHeader*  header;
+    size_t                      size;
+    void*                       file_handle;
+    void*                       mapping_handle;
+
+    PuzzleLibrary() { header = NULL; size = 0; file_handle = mapping_handle = NULL; }
+    ~PuzzleLibrary() { Close(); }
+    bool                Open(const char* file_name); // False if the file is missing or not a valid library
+    void                Close();
+    bool                IsOpen() const { return header != NULL; }
+    int                 Count(int difficulty) const;
+    const PuzzleRecord* Get(int difficulty, int n) const; // n-th highest scoring board of 'difficulty'
+    const PuzzleRecord* Daily(int difficulty, unsigned int day) const; // Same board for everyone on 'day'
+};
+
+// Bump allocator owning everything one game creates, from WordHuntGamePhase_Generate until the next game starts.
+// Reset() runs the registered destructors, newest first, and rewinds to the first block: blocks are kept, so memory
+// stays at the size of the largest game however many rounds are played.
+struct SessionArena
+{
+    struct Block
+    {
+        char*           data;
+        size_t          size;
+    };
+    struct Destructor
+    {
+        void            (*destroy)(void* object);
+        void*           object;
+    };
+
+    std::vector<Block>      blocks;
+    std::vector<Destructor> destructors;
+    size_t                  block_size;     // Size of a new block, larger allocations get a block of their own
+    int                     block_index;    // Block being carved
+    size_t                  block_used;     // Bytes of it handed out
+
+    SessionArena(size_t _block_size = 256 * 1024) { block_size = _block_size; block_index = 0; block_used = 0; }
+    ~SessionArena();
+    SessionArena(const SessionArena&) = delete;
+    SessionArena& operator=(const SessionArena&) = delete;
+    void*   Alloc(size_t size, size_t alignment = alignof(std::max_align_t));
+    void    Reset();
+    size_t  BytesReserved() const;
+
+    template<typename T, typename... Args>
+    T* New(Args&&... args)
+    {
+        T* object = new (Alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if (!std::is_trivially_destructible<T>::value)
+        {
+            Destructor destructor = { [](void* p) { ((T*)p)->~T(); }, object };
+            destructors.push_back(destructor);
+        }
+        return object;
+    }
+};
+
+// Objects of the running game come from the session arena when one is set (see WordHunt::SetSessionArena), from the
+// heap otherwise. The arena is not thread safe, only one thread at a time may allocate from it.
+template<typename T, typename... Args>
+T* WordHunt::SessionNew(Args&&... args)
+{
+    SessionArena* arena = GetSessionArena();
+    return arena ? arena->New<T>(std::forward<Args>(args)...) : new T(std::forward<Args>(args)...);
+}
+
 struct Solver
 {
-    std::vector<std::vector<char>> grid;
-    std::vector<std::vector<bool>> visited;
+    BoardGraph graph;
+    std::vector<const char*> tiles;
+    std::vector<TileCode> codes;
+    std::vector<unsigned int> neighbor_mask; // Per tile, first letters its neighbors can continue with
+    std::vector<std::unordered_map<const LetterNode*, unsigned int>> blank_memo; // Per blank tile, viable letters by trie node
+    std::vector<char> visited;
     std::set<Solution*, SolutionPointerComparator> sol_list;
-    const int dr[3] = { -1, 0 , 1 };
-    const int dc[3] = { -1, 0 , 1 };
+
+    // Filled once the solve is done: every distinct word gets an ID, its index in sol_list order
+    std::vector<Solution*> words;
+    std::unordered_map<const LetterNode*, int> word_ids; // Trie node ending a word -> ID
+    int total_points;
 
     Solver(char* letters, Seed* seed);
+    int WordId(const LetterNode* node) const; // -1 when the board does not hold the word
 };
@@ -7,14 +7,19 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 
 #include "wordhunt_styles.h"
+#include "imgui/imgui_internal.h"
 #include "macros.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 //-------------------------------------------------------------------------
 // [SECTION] SETUP
 //-------------------------------------------------------------------------
 
-WHStyle* default = new WHStyle();
-WHStyle* current = default;
+WHStyle* default_style = new WHStyle();
+WHStyle* current = default_style;
 WHStyle* config;
 
 WHStyle::WHStyle()
@@ -36,6 +41,7 @@ WHStyle::WHStyle()
 
     // Text Graphics
     TextSize = FontSize_20px;
+    TextGlyphs = FontGlyphs_Text;
     TextCol = IM_COL32(0, 0, 0, 255);
 
     // Button
@@ -59,6 +65,7 @@ WHStyle::WHStyle()
     TilePadding = 12.0f;
     TileRounding = 15.0f;
     TileTextSize = FontSize_80px;
+    TileTextGlyphs = FontGlyphs_Letters;
     TileSize = ImVec2(100, 100);
     TileBackgroundCol_Default = IM_COL32(236, 205, 155, 255);
     TileBackgroundCol_Valid = IM_COL32(141, 233, 133, 225);
@@ -80,220 +87,191 @@ WHStyle::WHStyle()
     SolutionItemRounding = 5.0f;
     SolutionItemCol_Background = IM_COL32(255, 255, 255, 255);
     SolutionItemCol_Text = IM_COL32(0, 0, 0, 255);
+    SolutionItemGlyphs = FontGlyphs_Words;
     SolutionExplorerCol;
     SolutionExplorerMaxSize = ImVec2(300,700);
     SolutionScoreSize = FontSize_36px;
+    SolutionScoreGlyphs = FontGlyphs_Numerals;
     SolutionScoreCol;
 }
 
+// Fonts go into the atlas the first time FontRetrieve() asks for them instead of all 170 at startup.
+// The atlas is locked during a frame, so a font first asked for mid frame is queued and the default font drawn
+// in its place, UpdateFonts() adds the queue and the renderer uploads the rebuilt atlas before the next frame.
+static const char* FontFiles[FontFamily_COUNT] =
+{
+    "../../misc/fonts/NotoSerif-Black.ttf",
+    "../../misc/fonts/NotoSerif-Bold.ttf",
+    "../../misc/fonts/NotoSerif-ExtraBold.ttf",
+    "../../misc/fonts/NotoSerif-ExtraLight.ttf",
+    "../../misc/fonts/NotoSerif-Italic.ttf",
+    "../../misc/fonts/NotoSerif-Light.ttf",
+    "../../misc/fonts/NotoSerif-Medium.ttf",
+    "../../misc/fonts/NotoSerif-Regular.ttf",
+    "../../misc/fonts/NotoSerif-SemiBold.ttf",
+    "../../misc/fonts/NotoSerif-Thin.ttf",
+    "../../misc/fonts/OpenSans-Bold.ttf",
+    "../../misc/fonts/OpenSans-ExtraBold.ttf",
+    "../../misc/fonts/OpenSans-Italic.ttf",
+    "../../misc/fonts/OpenSans-Light.ttf",
+    "../../misc/fonts/OpenSans-Medium.ttf",
+    "../../misc/fonts/OpenSans-Regular.ttf",
+    "../../misc/fonts/OpenSans-SemiBold.ttf",
+};
+static const float FontPixelSizes[FontSize_COUNT] = { 16.0f, 18.0f, 20.0f, 24.0f, 30.0f, 36.0f, 42.0f, 48.0f, 64.0f, 80.0f };
+static ImFont* LoadedFonts[FontFamily_COUNT][FontSize_COUNT][FontGlyphs_COUNT];
+static ImVector<int> PendingFonts; // (family * FontSize_COUNT + size) * FontGlyphs_COUNT + glyphs
+
+// Glyph ranges of the FontGlyphs_ sets, NULL is the atlas default. Each has '?' and '.' for the fallback and ellipsis glyphs.
+static const ImWchar FontGlyphRangesLetters[] = { 0x0020, 0x0020, '.', '.', '?', '?', 'A', 'Z', 'a', 'z', 0 };
+static const ImWchar FontGlyphRangesNumerals[] = { 0x0020, 0x0020, '%', '%', '+', '+', '-', ':', '?', '?', 0 }; // '-' to ':' are "-./0123456789:"
+static const ImWchar FontGlyphRangesWords[] = { 0x0020, 0x0020, '%', '%', '+', '+', '-', ':', '?', '?', 'A', 'Z', 'a', 'z', 0 };
+static const ImWchar* FontGlyphRanges[FontGlyphs_COUNT] = { NULL, FontGlyphRangesLetters, FontGlyphRangesNumerals, FontGlyphRangesWords };
+
+// When the renderer resolves signed distance fields, a family goes into the atlas once, at FontDistanceFieldSize, and its
+// other sizes are copies of that font drawn with their own ImFont::Scale, refreshed each time the atlas is built.
+// No bundled renderer backend resolves them yet, so every size is still rasterized on its own.
+static const FontSize FontDistanceFieldSize = FontSize_48px;
+static bool FontDistanceFields = false;
+
+// Glyph and white pixel UVs move each time the atlas is built, RecordedDrawList records again when this changes
+static int FontAtlasBuildCount = 0;
+
+static void CopyScaledFont(FontFamily ff, FontSize fs, FontGlyphs fg)
+{
+    const ImFont* src = LoadedFonts[ff][FontDistanceFieldSize][fg];
+    ImFont* dst = LoadedFonts[ff][fs][fg];
+    *dst = *src;
+    dst->Scale = FontPixelSizes[fs] / FontPixelSizes[FontDistanceFieldSize];
+    dst->FallbackGlyph = src->FallbackGlyph ? dst->Glyphs.Data + (src->FallbackGlyph - src->Glyphs.Data) : NULL;
+}
+
+static ImFont* AddFont(FontFamily ff, FontSize fs, FontGlyphs fg)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    const FontSize atlas_fs = FontDistanceFields ? FontDistanceFieldSize : fs;
+    if (LoadedFonts[ff][atlas_fs][fg] == NULL)
+    {
+        ImFontConfig config;
+        config.SignedDistanceField = FontDistanceFields;
+        LoadedFonts[ff][atlas_fs][fg] = io.Fonts->AddFontFromFileTTF(FontFiles[ff], FontPixelSizes[atlas_fs], &config, FontGlyphRanges[fg]);
+        IM_ASSERT(LoadedFonts[ff][atlas_fs][fg] != NULL);
+    }
+    if (LoadedFonts[ff][fs][fg] == NULL)
+    {
+        LoadedFonts[ff][fs][fg] = IM_NEW(ImFont)();
+        if (io.Fonts->IsBuilt())
+        {
+            CopyScaledFont(ff, fs, fg);
+        }
+    }
+    return LoadedFonts[ff][fs][fg];
+}
+
+// Restores the atlas from the cache file when it was written for the same fonts, or builds it and rewrites that file.
+// One file holds the latest set of fonts, its header hash rejects it after the lazy loading adds a font.
+static void BuildFontAtlas()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    if (atlas->IsBuilt())
+    {
+        return;
+    }
+    const ImU64 input_hash = atlas->GetBuildInputHash();
+    if (!atlas->LoadBuildCache("wordhunt_fonts.cache", input_hash))
+    {
+        atlas->Build();
+        atlas->SaveBuildCache("wordhunt_fonts.cache", input_hash);
+    }
+    FontAtlasBuildCount++;
+    for (int ff = 0; ff < FontFamily_COUNT && FontDistanceFields; ff++)
+    {
+        for (int fs = 0; fs < FontSize_COUNT; fs++)
+        {
+            for (int fg = 0; fg < FontGlyphs_COUNT; fg++)
+            {
+                if (fs != FontDistanceFieldSize && LoadedFonts[ff][fs][fg] != NULL)
+                {
+                    CopyScaledFont(ff, fs, fg);
+                }
+            }
+        }
+    }
+}
+
+// ImFontAtlas::ParallelForFn, the atlas build rasterizes one font source per call on every core
+static void FontAtlasParallelFor(void (*func)(void* func_data, int index), void* func_data, int count)
+{
+    std::atomic<int> next_index(0);
+    auto worker = [&]()
+    {
+        for (int index = next_index++; index < count; index = next_index++)
+        {
+            func(func_data, index);
+        }
+    };
+    const int thread_count = std::max(1, std::min((int)std::thread::hardware_concurrency(), count));
+    std::vector<std::thread> threads;
+    for (int i = 1; i < thread_count; i++)
+    {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
 void WHGui::LoadFonts()
 {
-    ImGuiIO& io = ImGui::GetIO(); (void)io;
-
-    // NotoSerif-Black
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Black.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Black.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Black.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Black.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Black.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Black.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Black.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Black.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Black.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Black.ttf", 80.0f);
-
-    // NotoSerif-Bold
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Bold.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Bold.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Bold.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Bold.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Bold.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Bold.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Bold.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Bold.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Bold.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Bold.ttf", 80.0f);
-
-    // NotoSerif-ExtraBold
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraBold.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraBold.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraBold.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraBold.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraBold.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraBold.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraBold.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraBold.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraBold.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraBold.ttf", 80.0f);
-
-    // NotoSerif-ExtraLight
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraLight.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraLight.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraLight.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraLight.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraLight.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraLight.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraLight.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraLight.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraLight.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-ExtraLight.ttf", 80.0f);
-
-    // NotoSerif-Italic
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Italic.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Italic.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Italic.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Italic.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Italic.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Italic.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Italic.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Italic.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Italic.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Italic.ttf", 80.0f);
-
-    // NotoSerif-Light
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Light.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Light.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Light.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Light.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Light.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Light.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Light.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Light.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Light.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Light.ttf", 80.0f);
-
-    // NotoSerif-Medium
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Medium.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Medium.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Medium.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Medium.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Medium.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Medium.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Medium.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Medium.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Medium.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Medium.ttf", 80.0f);
-
-    // NotoSerif-Regular
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Regular.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Regular.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Regular.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Regular.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Regular.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Regular.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Regular.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Regular.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Regular.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Regular.ttf", 80.0f);
-
-    // NotoSerif-SemiBold
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-SemiBold.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-SemiBold.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-SemiBold.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-SemiBold.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-SemiBold.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-SemiBold.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-SemiBold.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-SemiBold.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-SemiBold.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-SemiBold.ttf", 80.0f);
-
-    // NotoSerif-Thin
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Thin.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Thin.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Thin.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Thin.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Thin.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Thin.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Thin.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Thin.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Thin.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/NotoSerif-Thin.ttf", 80.0f);
-
-    // OpenSans-Bold
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Bold.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Bold.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Bold.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Bold.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Bold.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Bold.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Bold.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Bold.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Bold.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Bold.ttf", 80.0f);
-
-    // OpenSans-ExtraBold
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-ExtraBold.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-ExtraBold.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-ExtraBold.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-ExtraBold.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-ExtraBold.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-ExtraBold.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-ExtraBold.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-ExtraBold.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-ExtraBold.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-ExtraBold.ttf", 80.0f);
-
-    // OpenSans-Italic
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Italic.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Italic.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Italic.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Italic.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Italic.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Italic.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Italic.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Italic.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Italic.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Italic.ttf", 80.0f);
-
-    // OpenSans-Light
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Light.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Light.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Light.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Light.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Light.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Light.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Light.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Light.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Light.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Light.ttf", 80.0f);
-
-    // OpenSans-Medium
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Medium.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Medium.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Medium.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Medium.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Medium.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Medium.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Medium.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Medium.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Medium.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Medium.ttf", 80.0f);
-
-    // OpenSans-Regular
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Regular.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Regular.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Regular.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Regular.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Regular.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Regular.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Regular.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Regular.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Regular.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-Regular.ttf", 80.0f);
-
-    // OpenSans-SemiBold
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-SemiBold.ttf", 16.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-SemiBold.ttf", 18.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-SemiBold.ttf", 20.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-SemiBold.ttf", 24.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-SemiBold.ttf", 30.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-SemiBold.ttf", 36.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-SemiBold.ttf", 42.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-SemiBold.ttf", 48.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-SemiBold.ttf", 64.0f);
-    io.Fonts->AddFontFromFileTTF("../../misc/fonts/OpenSans-SemiBold.ttf", 80.0f);
+    ImGuiIO& io = ImGui::GetIO();
+    io.Fonts->ParallelForFn = FontAtlasParallelFor;
+    FontDistanceFields = (io.BackendFlags & ImGuiBackendFlags_RendererHasSignedDistanceFields) != 0;
+
+    io.FontDefault = AddFont(NotoSerifBlack, FontSize_16px, FontGlyphs_Text);
+
+    // The fonts of the first screen, the rest are added as they are drawn
+    WHStyle* styler = WHGui::GetWHStyle();
+    WHGui::FontRetrieve(styler->TitleFontFamily, styler->TitleTextSize, styler->TextGlyphs);
+    WHGui::FontRetrieve(styler->ThemeFontFamily, styler->ButtonTextSize, styler->TextGlyphs);
+    BuildFontAtlas();
+}
+
+bool WHGui::HasPendingFonts()
+{
+    return !PendingFonts.empty();
+}
+
+// Call between frames, after the renderer released its font texture, it is rebuilt from the new atlas
+void WHGui::UpdateFonts()
+{
+    for (int key : PendingFonts)
+    {
+        AddFont(key / FontGlyphs_COUNT / FontSize_COUNT, key / FontGlyphs_COUNT % FontSize_COUNT, key % FontGlyphs_COUNT);
+    }
+    PendingFonts.resize(0);
+    BuildFontAtlas();
+}
 
+// Frees the scaled signed distance field copies, the atlas owns every other font. Call before ImGui::DestroyContext().
+void WHGui::UnloadFonts()
+{
+    for (int ff = 0; ff < FontFamily_COUNT; ff++)
+    {
+        for (int fs = 0; fs < FontSize_COUNT; fs++)
+        {
+            for (int fg = 0; fg < FontGlyphs_COUNT; fg++)
+            {
+                if (FontDistanceFields && fs != FontDistanceFieldSize)
+                {
+                    IM_DELETE(LoadedFonts[ff][fs][fg]);
+                }
+                LoadedFonts[ff][fs][fg] = NULL;
+            }
+        }
+    }
+    PendingFonts.clear();
 }
 
 WHStyle* WHGui::GetWHStyle()
@@ -303,7 +281,7 @@ WHStyle* WHGui::GetWHStyle()
 
 void WHGui::ResetToDefaultWHStyle()
 {
-    current = default;
+    current = default_style;
 }
 
 WHStyle* WHGui::LoadStyleFromFile(const char* filename)
@@ -311,10 +289,34 @@ WHStyle* WHGui::LoadStyleFromFile(const char* filename)
     return config;
 }
 
-ImFont* WHGui::FontRetrieve(FontFamily ff, FontSize fs)
+ImFont* WHGui::FontRetrieve(FontFamily ff, FontSize fs, FontGlyphs fg)
 {
+    if (ImFont* font = LoadedFonts[ff][fs][fg])
+    {
+        return font;
+    }
+    if (ImFont* font = LoadedFonts[ff][fs][FontGlyphs_Text])
+    {
+        // The text set has every glyph of the others
+        return font;
+    }
     ImGuiIO& io = ImGui::GetIO();
-    return io.Fonts->Fonts[ff * 10 + fs];
+    if (!io.Fonts->Locked)
+    {
+        // Outside a frame (setup), the atlas is built again before the renderer's first frame
+        return AddFont(ff, fs, fg);
+    }
+    if (FontDistanceFields && LoadedFonts[ff][FontDistanceFieldSize][fg] != NULL)
+    {
+        // Another size of a family already in the atlas, a scaled copy of its font
+        return AddFont(ff, fs, fg);
+    }
+    const int key = (ff * FontSize_COUNT + fs) * FontGlyphs_COUNT + fg;
+    if (!PendingFonts.contains(key))
+    {
+        PendingFonts.push_back(key);
+    }
+    return io.FontDefault;
 }
 
 //-------------------------------------------------------------------------
@@ -327,7 +329,7 @@ void WHGui::PushTitleStyle()
     ImGuiIO io = ImGui::GetIO();
     WHStyle* styler = WHGui::GetWHStyle();
 
-    ImGui::PushFont(WHGui::FontRetrieve(styler->TitleFontFamily, styler->TitleTextSize));
+    ImGui::PushFont(WHGui::FontRetrieve(styler->TitleFontFamily, styler->TitleTextSize, styler->TextGlyphs));
     ImGui::PushStyleColor(ImGuiCol_Text, styler->TitleCol);
 }
 
@@ -342,7 +344,7 @@ void WHGui::PushButtonStyle()
     ImGuiIO io = ImGui::GetIO();
     WHStyle* styler = WHGui::GetWHStyle();
 
-    ImGui::PushFont(WHGui::FontRetrieve(styler->ThemeFontFamily, styler->ButtonTextSize));
+    ImGui::PushFont(WHGui::FontRetrieve(styler->ThemeFontFamily, styler->ButtonTextSize, styler->TextGlyphs));
 
     ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, styler->ButtonRounding);
     ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, styler->ButtonPadding);
@@ -387,46 +389,353 @@ void WHGui::PopWindowStyle()
 // [SECTION] CUSTOM OBJECTS
 //-------------------------------------------------------------------------
 
+// 'list_id' keeps the same word in two lists apart
+void WHGui::BuildSolutionItem(SolutionItemCache* item, Solution* entry, const char* list_id)
+{
+    item->solution = entry;
+    item->id = ImHashStr(entry->word, 0, ImHashStr(list_id));
+    item->font = NULL;
+    item->word_size = item->points_size = ImVec2(0, 0);
+    ImFormatString(item->points, IM_ARRAYSIZE(item->points), "%d", entry->GetPointValue());
+}
+
+// Word on a rounded 'solution_color' tag at the left, points at the right, drawn straight into the window's draw list.
 // Returns true if solution item hovered
-bool WHGui::SolutionItem(Solution* entry, const ImVec2& size, ImU32 solution_color, ImGuiWindowFlags flags, const std::string prefix)
+bool WHGui::SolutionItem(SolutionItemCache* item, const ImVec2& size, ImU32 solution_color)
+{
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems)
+    {
+        return false;
+    }
+
+    ImFont* font = ImGui::GetFont();
+    const float font_size = ImGui::GetFontSize();
+    if (item->font != font)
+    {
+        item->word_size = font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, item->solution->word);
+        item->points_size = font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, item->points);
+        item->font = font;
+    }
+
+    const ImVec2 padding = ImVec2(5, 2.5f);
+    const ImVec2 pos = window->DC.CursorPos;
+    const ImRect bb(pos, pos + ImVec2(size.x > 0.0f ? size.x : ImGui::GetContentRegionAvail().x, size.y));
+    ImGui::ItemSize(bb);
+    if (!ImGui::ItemAdd(bb, item->id))
+    {
+        return false;
+    }
+
+    const ImGuiStyle& style = ImGui::GetStyle();
+    ImDrawList* draw_list = window->DrawList;
+    const ImU32 background = ImGui::GetColorU32(ImGuiCol_ChildBg);
+    if (background & IM_COL32_A_MASK)
+    {
+        draw_list->AddRectFilled(bb.Min, bb.Max, background, style.ChildRounding);
+    }
+    draw_list->AddRectFilled(pos, pos + item->word_size + padding * 2, solution_color, style.ChildRounding);
+    draw_list->AddText(font, font_size, pos + padding, ImGui::GetColorU32(ImGuiCol_Text), item->solution->word);
+    draw_list->AddText(font, font_size, bb.Max - item->points_size - padding, IM_COL32(255, 255, 255, 255), item->points);
+    return ImGui::IsItemHovered();
+}
+
+ImVec2 BoardWidgetLayout::Size() const
 {
-    std::string solution_id = prefix + " : " + entry->to_string();
-    solution_id += " tile";
-    bool is_hovered = false;
-    if (ImGui::BeginChild(solution_id.data(), size, false, flags))
+    ImVec2 size = tile_size * ImVec2(float(cols), float(rows)) + spacing * ImVec2(float(cols - 1), float(rows - 1));
+    if (hex && rows > 1)
     {
-        ImVec2 text_dimensions = ImGui::CalcTextSize(entry->word);
-        ImVec2 padding = ImVec2(5, 2.5f);
+        size.x += (tile_size.x + spacing.x) * 0.5f;
+    }
+    return size;
+}
+
+ImVec2 BoardWidgetLayout::TileMin(int row, int col) const
+{
+    ImVec2 pos = origin + (tile_size + spacing) * ImVec2(float(col), float(row));
+    if (hex && (row & 1))
+    {
+        pos.x += (tile_size.x + spacing.x) * 0.5f;
+    }
+    return pos;
+}
+
+ImVec2 BoardWidgetLayout::TileCenter(int row, int col) const
+{
+    return TileMin(row, col) + tile_size * 0.5f;
+}
 
-        static char buf[6] = { 0 };
-        int point_value = WordHunt::GetPointVal(entry->length), i = 4;
-        while (point_value && i)
+// The row comes from y and the column from x once the odd row offset is taken out, no loop over the tiles.
+int BoardWidgetLayout::HitTest(const ImVec2& pos) const
+{
+    const ImVec2 pitch = tile_size + spacing;
+    const float y = pos.y - origin.y;
+    const int row = y >= 0.0f ? int(y / pitch.y) : -1;
+    if (row < 0 || row >= rows)
+    {
+        return -1;
+    }
+    const float x = pos.x - origin.x - ((hex && (row & 1)) ? pitch.x * 0.5f : 0.0f);
+    const int col = x >= 0.0f ? int(x / pitch.x) : -1;
+    if (col < 0 || col >= cols)
+    {
+        return -1;
+    }
+    const float cell_x = x - pitch.x * col;
+    const float cell_y = y - pitch.y * row;
+    if (cell_x < hit_padding || cell_x >= tile_size.x - hit_padding || cell_y < hit_padding || cell_y >= tile_size.y - hit_padding)
+    {
+        return -1;
+    }
+    return row * cols + col;
+}
+
+// Clips a + (b - a) * t against the rectangle, returns the t where the segment enters it or -1.0f when it misses.
+static float SegmentEntersRect(const ImVec2& a, const ImVec2& b, const ImVec2& rect_min, const ImVec2& rect_max)
+{
+    float t_enter = 0.0f, t_exit = 1.0f;
+    const float delta[2] = { b.x - a.x, b.y - a.y };
+    const float start[2] = { a.x, a.y };
+    const float lo[2] = { rect_min.x, rect_min.y };
+    const float hi[2] = { rect_max.x, rect_max.y };
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (delta[axis] == 0.0f)
         {
-            buf[i--] = "0123456789"[point_value % 10];
-            point_value /= 10;
+            if (start[axis] < lo[axis] || start[axis] >= hi[axis])
+            {
+                return -1.0f;
+            }
+            continue;
         }
+        float t0 = (lo[axis] - start[axis]) / delta[axis];
+        float t1 = (hi[axis] - start[axis]) / delta[axis];
+        if (t0 > t1)
+        {
+            ImSwap(t0, t1);
+        }
+        t_enter = ImMax(t_enter, t0);
+        t_exit = ImMin(t_exit, t1);
+        if (t_enter > t_exit)
+        {
+            return -1.0f;
+        }
+    }
+    return t_enter;
+}
 
-        ImVec2 point_dimensions = ImGui::CalcTextSize(&buf[i + 1]);
-
-        ImGui::PushStyleColor(ImGuiCol_ChildBg, solution_color);
+// Only the cells in the segment's bounding rows and columns are clipped, a swipe between two samples crosses a handful.
+int BoardWidgetLayout::TilesAlong(const ImVec2& a, const ImVec2& b, int* tiles, int capacity) const
+{
+    if (a.x == b.x && a.y == b.y)
+    {
+        const int tile = HitTest(a);
+        if (tile < 0 || capacity < 1)
+        {
+            return 0;
+        }
+        tiles[0] = tile;
+        return 1;
+    }
+    const ImVec2 pitch = tile_size + spacing;
+    const ImVec2 pad = ImVec2(hit_padding, hit_padding);
+    const int row_min = ImMax(0, int(ImFloor((ImMin(a.y, b.y) - origin.y) / pitch.y)));
+    const int row_max = ImMin(rows - 1, int(ImFloor((ImMax(a.y, b.y) - origin.y) / pitch.y)));
+    const int col_min = ImMax(0, int(ImFloor((ImMin(a.x, b.x) - origin.x) / pitch.x)) - (hex ? 1 : 0));
+    const int col_max = ImMin(cols - 1, int(ImFloor((ImMax(a.x, b.x) - origin.x) / pitch.x)));
+    float entries[WORDHUNT_MAX_SIDE * WORDHUNT_MAX_SIDE];
+    capacity = ImMin(capacity, IM_ARRAYSIZE(entries));
+    int count = 0;
+    for (int row = row_min; row <= row_max; row++)
+    {
+        for (int col = col_min; col <= col_max && count < capacity; col++)
+        {
+            const ImVec2 tile_min = TileMin(row, col);
+            const float t = SegmentEntersRect(a, b, tile_min + pad, tile_min + tile_size - pad);
+            if (t < 0.0f)
+            {
+                continue;
+            }
+            // Insertion keeps the tiles ordered from a to b
+            int n = count++;
+            for (; n > 0 && entries[n - 1] > t; n--)
+            {
+                entries[n] = entries[n - 1];
+                tiles[n] = tiles[n - 1];
+            }
+            entries[n] = t;
+            tiles[n] = row * cols + col;
+        }
+    }
+    return count;
+}
 
-        if (ImGui::BeginChild(entry->word, text_dimensions + padding * 2))
+// Appends the active tiles along a..b to crossed_tiles, skipping the one already at the end
+static void AddCrossedTiles(const BoardWidgetLayout& layout, const Seed* seed, const ImVec2& a, const ImVec2& b, int* crossed_tiles, int crossed_capacity, int* crossed_count)
+{
+    int tiles[WORDHUNT_MAX_SIDE * WORDHUNT_MAX_SIDE];
+    const int count = layout.TilesAlong(a, b, tiles, IM_ARRAYSIZE(tiles));
+    for (int n = 0; n < count && *crossed_count < crossed_capacity; n++)
+    {
+        if (!seed->IsActive(tiles[n] / layout.cols, tiles[n] % layout.cols))
         {
-            ImGui::SetCursorPos(padding);
-            ImGui::Text(entry->word);
+            continue;
         }
-        ImGui::EndChild();
+        if (*crossed_count > 0 && crossed_tiles[*crossed_count - 1] == tiles[n])
+        {
+            continue;
+        }
+        crossed_tiles[(*crossed_count)++] = tiles[n];
+    }
+}
+
+RecordedDrawList::~RecordedDrawList()
+{
+    if (draw_list != NULL)
+    {
+        IM_DELETE(draw_list);
+    }
+}
+
+bool RecordedDrawList::Record(ImGuiID content_key)
+{
+    ImDrawListSharedData* shared_data = ImGui::GetDrawListSharedData();
+    struct { ImGuiID content_key; int atlas_build; ImDrawListFlags flags; float circle_max_error; } state = { content_key, FontAtlasBuildCount, shared_data->InitialFlags, shared_data->CircleSegmentMaxError };
+    const ImGuiID state_key = ImHashData(&state, sizeof(state));
+    if (draw_list != NULL && key == state_key)
+    {
+        return false;
+    }
+    if (draw_list == NULL)
+    {
+        draw_list = IM_NEW(ImDrawList)(shared_data);
+    }
+    draw_list->_ResetForNewFrame();
+    draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    draw_list->PushClipRectFullScreen();
+    key = state_key;
+    return true;
+}
 
-        ImGui::PopStyleColor();
+void RecordedDrawList::Draw(ImDrawList* dst, const ImVec2& pos) const
+{
+    dst->AddDrawList(draw_list, pos);
+}
+
+// Every tile, its letters and border go into the current window's draw list as one item, inactive tiles are left out.
+// Takes the font, text color and ChildRounding in effect.
+// The tiles are recorded into 'tiles' and replayed until their colors, letters or style change.
+// Fills crossed_tiles with the active tiles the left button dragged over this frame, in order, and returns their count.
+// The mouse positions queued since the last frame are replayed from the input trail, so a fast swipe that moves
+// several tiles between two frames still reports every tile in between.
+int WHGui::Board(const char* str_id, const BoardWidgetLayout& layout, const Seed* seed, const char* letters, const ImU32* tile_colors, RecordedDrawList* tiles, int* crossed_tiles, int crossed_capacity)
+{
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems)
+    {
+        return 0;
+    }
+    const ImRect bb(layout.origin, layout.origin + layout.Size());
+    const ImGuiID id = window->GetID(str_id);
+    ImGui::ItemSize(bb);
+    if (!ImGui::ItemAdd(bb, id))
+    {
+        return 0;
+    }
+    // A drag that starts on the board belongs to it, the window underneath does not move
+    bool hovered, held;
+    ImGui::ButtonBehavior(bb, id, &hovered, &held);
+
+    // Recorded at the fractional part of the board position, the letters land on the same pixels as when drawn in place
+    const ImGuiStyle& style = ImGui::GetStyle();
+    const ImVec2 draw_pos = ImFloor(layout.origin);
+    BoardWidgetLayout local_layout = layout;
+    local_layout.origin = layout.origin - draw_pos;
+    struct
+    {
+        ImVec2  origin, tile_size, spacing;
+        int     rows, cols, hex;
+        ImFont* font;
+        float   font_size, rounding, border_size;
+        ImU32   text_color, border_color;
+    } tiles_state;
+    memset((void*)&tiles_state, 0, sizeof(tiles_state)); // Hashed with its padding
+    tiles_state.origin = local_layout.origin;
+    tiles_state.tile_size = layout.tile_size;
+    tiles_state.spacing = layout.spacing;
+    tiles_state.rows = layout.rows;
+    tiles_state.cols = layout.cols;
+    tiles_state.hex = layout.hex;
+    tiles_state.font = ImGui::GetFont();
+    tiles_state.font_size = ImGui::GetFontSize();
+    tiles_state.rounding = style.ChildRounding;
+    tiles_state.border_size = style.ChildBorderSize;
+    tiles_state.text_color = ImGui::GetColorU32(ImGuiCol_Text);
+    tiles_state.border_color = ImGui::GetColorU32(ImGuiCol_Border);
+    const int tile_count = layout.rows * layout.cols;
+    ImGuiID tiles_key = ImHashData(&tiles_state, sizeof(tiles_state));
+    tiles_key = ImHashData(seed->board, sizeof(seed->board), tiles_key);
+    tiles_key = ImHashData(tile_colors, sizeof(ImU32) * tile_count, tiles_key);
+    tiles_key = ImHashData(letters, (size_t)tile_count * WORDHUNT_TILE_STRIDE, tiles_key);
+    if (tiles->Record(tiles_key))
+    {
+        // Every letter after every tile, the letters of a distance field font share one ImDrawCallback_SetSignedDistanceField pair
+        ImDrawList* draw_list = tiles->draw_list;
+        for (int tile_index = seed->NextActive(-1); tile_index >= 0 && tile_index < tile_count; tile_index = seed->NextActive(tile_index))
+        {
+            const ImVec2 tile_min = local_layout.TileMin(tile_index / layout.cols, tile_index % layout.cols);
+            const ImVec2 tile_max = tile_min + layout.tile_size;
+            draw_list->AddRectFilled(tile_min, tile_max, tile_colors[tile_index], style.ChildRounding);
+            if (style.ChildBorderSize > 0.0f)
+            {
+                draw_list->AddRect(tile_min, tile_max, tiles_state.border_color, style.ChildRounding, 0, style.ChildBorderSize);
+            }
+        }
+        for (int tile_index = seed->NextActive(-1); tile_index >= 0 && tile_index < tile_count; tile_index = seed->NextActive(tile_index))
+        {
+            const ImVec2 tile_min = local_layout.TileMin(tile_index / layout.cols, tile_index % layout.cols);
+            const char* tile = letters + tile_index * WORDHUNT_TILE_STRIDE;
+            const ImVec2 text_size = tiles_state.font->CalcTextSizeA(tiles_state.font_size, FLT_MAX, 0.0f, tile);
+            draw_list->AddText(tiles_state.font, tiles_state.font_size, ImFloor(tile_min + (layout.tile_size - text_size) * 0.5f), tiles_state.text_color, tile);
+        }
+    }
+    tiles->Draw(window->DrawList, draw_pos);
 
-        ImGui::SetCursorPos(ImGui::GetWindowSize() - point_dimensions - padding);
-        ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 255, 255, 255));
-        ImGui::Text(&buf[i + 1]);
-        ImGui::PopStyleColor();
+    ImGuiContext& g = *GImGui;
+    const ImGuiIO& io = g.IO;
+    int crossed_count = 0;
+    if (!held && !ImGui::IsMouseHoveringRect(bb.Min, bb.Max))
+    {
+        return 0;
+    }
+    // Walk this frame's mouse events from where the mouse was at the end of the last frame
+    ImVec2 mouse_pos = io.MousePos - io.MouseDelta;
+    bool mouse_down = io.MouseDown[ImGuiMouseButton_Left] != (io.MouseClicked[ImGuiMouseButton_Left] || io.MouseReleased[ImGuiMouseButton_Left]);
+    for (const ImGuiInputEvent& e : g.InputEventsTrail)
+    {
+        if (e.Type == ImGuiInputEventType_MouseButton && e.MouseButton.Button == ImGuiMouseButton_Left)
+        {
+            mouse_down = e.MouseButton.Down;
+            if (mouse_down && ImGui::IsMousePosValid(&mouse_pos))
+            {
+                AddCrossedTiles(layout, seed, mouse_pos, mouse_pos, crossed_tiles, crossed_capacity, &crossed_count);
+            }
+        }
+        else if (e.Type == ImGuiInputEventType_MousePos)
+        {
+            const ImVec2 event_pos = ImVec2(e.MousePos.PosX, e.MousePos.PosY);
+            if (mouse_down && ImGui::IsMousePosValid(&mouse_pos) && ImGui::IsMousePosValid(&event_pos))
+            {
+                AddCrossedTiles(layout, seed, mouse_pos, event_pos, crossed_tiles, crossed_capacity, &crossed_count);
+            }
+            mouse_pos = event_pos;
+        }
+    }
+    if (io.MouseDown[ImGuiMouseButton_Left] && ImGui::IsMousePosValid(&io.MousePos))
+    {
+        AddCrossedTiles(layout, seed, io.MousePos, io.MousePos, crossed_tiles, crossed_capacity, &crossed_count);
     }
-    is_hovered = ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows);
-    ImGui::EndChild();
-    return is_hovered;
+    return crossed_count;
 }
 
 bool WHGui::Button(const char* label, const ImVec2& size)
@@ -5,8 +5,12 @@
 typedef int TileState;
 typedef int FontFamily;
 typedef int FontSize;
+typedef int FontGlyphs;
 
 struct WHStyle;
+struct SolutionItemCache;
+struct BoardWidgetLayout;
+struct RecordedDrawList;
 
 enum TileState_
 {
@@ -34,7 +38,8 @@ enum FontFamily_
     OpenSansLight,
     OpenSansMedium,
     OpenSansRegular,
-    OpenSansSemiBold
+    OpenSansSemiBold,
+    FontFamily_COUNT
 };
 
 enum FontSize_
@@ -48,7 +53,18 @@ enum FontSize_
     FontSize_42px,
     FontSize_48px,
     FontSize_64px,
-    FontSize_80px
+    FontSize_80px,
+    FontSize_COUNT
+};
+
+// Characters a font entry is rasterized with, for text known to use only some of them
+enum FontGlyphs_
+{
+    FontGlyphs_Text,        // Basic Latin + Latin-1 Supplement, has every glyph of the other sets
+    FontGlyphs_Letters,     // Tile letters
+    FontGlyphs_Numerals,    // Digits, scores and times
+    FontGlyphs_Words,       // Letters and numerals, e.g. solution rows
+    FontGlyphs_COUNT
 };
 
 namespace WHGui
@@ -58,7 +74,10 @@ namespace WHGui
     void ResetToDefaultWHStyle();
     WHStyle* LoadStyleFromFile(const char* filename);
     void LoadFonts();
-    ImFont* FontRetrieve(FontFamily ff, FontSize fs);
+    ImFont* FontRetrieve(FontFamily ff, FontSize fs, FontGlyphs fg = FontGlyphs_Text);
+    bool HasPendingFonts();
+    void UpdateFonts();
+    void UnloadFonts();
 
     // Style Modifiers
     void PushTitleStyle();
@@ -71,7 +90,9 @@ namespace WHGui
     void PopWindowStyle();
 
     // Custom Objects
-    bool SolutionItem(Solution* entry, const ImVec2& size, ImU32 solution_color, ImGuiWindowFlags flags = 0, const std::string prefix = "");
+    void BuildSolutionItem(SolutionItemCache* item, Solution* entry, const char* list_id);
+    bool SolutionItem(SolutionItemCache* item, const ImVec2& size, ImU32 solution_color);
+    int  Board(const char* str_id, const BoardWidgetLayout& layout, const Seed* seed, const char* letters, const ImU32* tile_colors, RecordedDrawList* tiles, int* crossed_tiles, int crossed_capacity);
     bool Clock(ImVec2 &size, bool border, ImGuiWindowFlags flags = 0);
     bool Button(const char* label, const ImVec2& size = ImVec2(0, 0));
 }
@@ -96,6 +117,7 @@ struct WHStyle
 
     // Text Graphics
     FontSize        TextSize;
+    FontGlyphs      TextGlyphs;
     ImU32           TextCol;
 
     // Button
@@ -123,6 +145,7 @@ struct WHStyle
     float           TilePadding;
     float           TileRounding;
     FontSize        TileTextSize;
+    FontGlyphs      TileTextGlyphs;
     ImVec2          TileSize;
     ImU32           TileBackgroundCol_Default;
     ImU32           TileBackgroundCol_Valid;
@@ -144,10 +167,58 @@ struct WHStyle
     float           SolutionItemRounding;
     ImU32           SolutionItemCol_Background;
     ImU32           SolutionItemCol_Text;
+    FontGlyphs      SolutionItemGlyphs;
     ImU32           SolutionExplorerCol;
     ImVec2          SolutionExplorerMaxSize;
     float           SolutionScoreSize;
+    FontGlyphs      SolutionScoreGlyphs;
     ImU32           SolutionScoreCol;
 
     WHStyle();
 };
+
+// A row of a solution list, filled once by WHGui::BuildSolutionItem() so drawing it formats and allocates nothing.
+// Text sizes are measured on the first draw, with the font of the list, and again only if that font changes.
+struct SolutionItemCache
+{
+    Solution*       solution;
+    ImGuiID         id;
+    ImFont*         font;           // Font word_size and points_size were measured with, NULL until the first draw
+    ImVec2          word_size;
+    ImVec2          points_size;
+    char            points[12];     // Point value as text
+};
+
+// Static shapes and text drawn once into their own draw list, then copied into a window's each frame with
+// ImDrawList::AddDrawList() instead of being tessellated again. Record() says when the content has to be drawn again:
+// the key it is given changed, or the font atlas or tessellation settings the recorded vertices depend on did.
+// Draw around the origin between Record() and Draw(), Draw() translates to the screen position.
+struct RecordedDrawList
+{
+    ImDrawList*     draw_list;      // NULL until the first Record()
+    ImGuiID         key;            // Content key mixed with the atlas and tessellation state it was recorded with
+
+    RecordedDrawList() : draw_list(NULL), key(0) {}
+    ~RecordedDrawList();
+
+    bool Record(ImGuiID content_key);               // True when draw_list was cleared and needs drawing into
+    void Draw(ImDrawList* dst, const ImVec2& pos) const;
+};
+
+// Geometry of a board drawn by WHGui::Board(), tiles are indexed row * cols + col like the letters buffer
+struct BoardWidgetLayout
+{
+    ImVec2          origin;         // Screen position of the board's top left corner
+    ImVec2          tile_size;
+    ImVec2          spacing;        // Gap between neighboring tiles
+    float           hit_padding;    // A tile is only hovered this far inside its edges, so diagonal drags miss the corners
+    int             rows;
+    int             cols;
+    bool            hex;            // Odd rows sit half a tile to the right
+
+    ImVec2 Size() const;
+    ImVec2 TileMin(int row, int col) const;
+    ImVec2 TileCenter(int row, int col) const;
+    int    HitTest(const ImVec2& pos) const;                                             // Tile index under pos, -1 when between tiles or outside
+    int    TilesAlong(const ImVec2& a, const ImVec2& b, int* tiles, int capacity) const; // Tiles the segment a..b enters, in order from a, returns the count
+};
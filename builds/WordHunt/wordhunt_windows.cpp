@@ -37,6 +37,12 @@ static void HelpMarker(const char* desc)
     }
 }
 
+// Only letters may be typed into a tile, multi-letter tiles ("QU") are allowed up to WORDHUNT_MAX_TILE_LEN
+static int TileCharFilter(ImGuiInputTextCallbackData* data)
+{
+    return (data->EventChar < 256 && isalpha(data->EventChar)) ? 0 : 1;
+}
+
 static void FullScreenNextWindow()
 {
     // Use entire work area (without menu-bars, task-bars etc.)
@@ -192,7 +198,7 @@ void ShowSolver(bool* p_open)
         if (ImGui::Button("Decrement Col") && numCols != 0)
             numCols--;
 
-        static char data[200] = "";
+        static char data[max * max * WORDHUNT_TILE_STRIDE + 1] = "";
 
         if (ImGui::BeginTable("Game Board", numCols, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
         {
@@ -205,14 +211,15 @@ void ShowSolver(bool* p_open)
                     ImU32 cell_bg_color = IM_COL32(236, 205, 155, 255);
                     ImGui::TableSetBgColor(ImGuiTableBgTarget_CellBg, cell_bg_color);
 
-                    ImGuiInputTextFlags textFlags = ImGuiInputTextFlags_CharsNoBlank | ImGuiInputTextFlags_CharsUppercase | ImGuiInputTextFlags_AlwaysOverwrite | ImGuiInputTextFlags_NoHorizontalScroll;
+                    ImGuiInputTextFlags textFlags = ImGuiInputTextFlags_CharsNoBlank | ImGuiInputTextFlags_CharsUppercase | ImGuiInputTextFlags_NoHorizontalScroll | ImGuiInputTextFlags_CallbackCharFilter;
 
 
                     char randomLabel[10] = "##RTile  ";
                     randomLabel[7] = char(row + '1');
                     randomLabel[8] = char(col + '1');
 
-                    ImGui::InputText(randomLabel, &data[(col * 10 + row) * 2], 2, textFlags);
+                    char* tile = WordHunt::GetTile(data, row * max + col);
+                    ImGui::InputText(randomLabel, tile, WORDHUNT_TILE_STRIDE, textFlags, TileCharFilter);
 
                     if (ImGui::IsItemHovered())
                         ImGui::TableSetBgColor(ImGuiTableBgTarget_CellBg, IM_COL32(190, 229, 176, 255));
@@ -0,0 +1,10 @@
+@REM Build for Visual Studio compiler. Run your copy of vcvars32.bat or vcvarsall.bat to setup command-line compiler.
+@REM Command line tools, they only need the WordHunt core (wordhunt.cpp) and no graphics libraries.
+@set OUT_DIR=Release
+@set INCLUDES=/I..\WordHunt
+@set CORE=..\WordHunt\wordhunt.cpp
+mkdir Release
+cl /nologo /O2 /EHsc /MD /utf-8 %INCLUDES% wordhunt_anneal.cpp %CORE% /Fe%OUT_DIR%/wordhunt_anneal.exe /Fo%OUT_DIR%/
+cl /nologo /O2 /EHsc /MD /utf-8 %INCLUDES% wordhunt_library.cpp %CORE% /Fe%OUT_DIR%/wordhunt_library.exe /Fo%OUT_DIR%/
+cl /nologo /O2 /EHsc /MD /utf-8 %INCLUDES% wordhunt_blanks.cpp %CORE% /Fe%OUT_DIR%/wordhunt_blanks.exe /Fo%OUT_DIR%/
+cl /nologo /O2 /EHsc /MD /utf-8 %INCLUDES% wordhunt_bench.cpp %CORE% /Fe%OUT_DIR%/wordhunt_bench.exe /Fo%OUT_DIR%/
@@ -0,0 +1,666 @@
+// WordHunt tools
+// (wordhunt_anneal.cpp)
+// Searches for the highest scoring letters on a board shape with simulated annealing, e.g. to publish "monster boards".
+
+// Tiles are drawn from the same tile set as WordHunt::GenerateGame() and scored against a compact copy of the trie.
+// Boards of up to 64 tiles keep every board path that spells a trie prefix, and for every word the number of paths
+// spelling it. A proposal drops the paths through the changed tile and walks on only from the kept paths ending next to
+// it, so a word is lost or gained exactly when its path count crosses zero. Larger boards rescore every path.
+// Independent chains run on their own threads and the best board over all chains is printed.
+
+// Build with, e.g:
+//   # cl.exe /O2 /EHsc /I..\WordHunt wordhunt_anneal.cpp ..\WordHunt\wordhunt.cpp
+//   # g++ -O2 -std=c++17 -pthread -I../WordHunt wordhunt_anneal.cpp ../WordHunt/wordhunt.cpp
+
+// Usage:
+//   wordhunt_anneal.exe [-chains N] [-iters N] [-temp T0 T1] [-seed N] <dictionary> [seed]
+// Usage example:
+//   # wordhunt_anneal.exe -chains 8 -iters 2000000 ..\..\misc\files\dictionary.txt R5C5>1111111111111111111111111[0]t75
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "wordhunt.h"
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <time.h>
+
+//-------------------------------------------------------------------------
+// [SECTION] COMPACT TRIE
+//-------------------------------------------------------------------------
+
+// Flattened copy of the dictionary trie. The children of a node are stored contiguously in letter order,
+// so a child is found from child_mask with one popcount and node indices double as word ids.
+struct AnnealNode
+{
+    unsigned int    child_mask;
+    int             first_child;
+    int             points;         // Points for the word ending here, 0 if none
+};
+
+struct AnnealTrie
+{
+    std::vector<AnnealNode> nodes;
+
+    int Child(int node, int letter) const
+    {
+        const AnnealNode& n = nodes[node];
+        if (!(n.child_mask & (1u << letter)))
+        {
+            return -1;
+        }
+        return n.first_child + (int)WordHunt::BitCount(n.child_mask & ((1u << letter) - 1));
+    }
+
+    int Advance(int node, const TileCode& code) const
+    {
+        for (int i = 0; i < code.length && node >= 0; i++)
+        {
+            node = Child(node, code.index[i]);
+        }
+        return node;
+    }
+};
+
+// Lays a subtree out depth first, a node's children block is allocated when the node is placed so a walk down the
+// board stays within nearby memory
+static void PlaceAnnealNode(AnnealTrie* trie, LetterNode* source, int index, int depth)
+{
+    const int first_child = (int)trie->nodes.size();
+    trie->nodes.resize(trie->nodes.size() + WordHunt::BitCount(source->child_mask));
+
+    AnnealNode& node = trie->nodes[index];
+    node.child_mask = source->child_mask;
+    node.first_child = first_child;
+    node.points = (source->end_of_word && depth >= WordHunt::GetMinWordLength()) ? WordHunt::GetPointVal(depth) : 0;
+
+    int child_index = first_child;
+    for (unsigned int mask = source->child_mask; mask; mask &= mask - 1, child_index++)
+    {
+        PlaceAnnealNode(trie, source->children[WordHunt::LowestBit(mask)], child_index, depth + 1);
+    }
+}
+
+static void BuildAnnealTrie(AnnealTrie* trie, LetterNode* root)
+{
+    trie->nodes.assign(1, AnnealNode());
+    PlaceAnnealNode(trie, root, 0, 0);
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] ANNEALING CHAIN
+//-------------------------------------------------------------------------
+
+// Boards of up to this many tiles rescore incrementally, a path's tiles then fit one 64-bit mask
+#define ANNEAL_INCREMENTAL_MAX_TILES    64
+
+static inline int LowestBit64(unsigned long long mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// A board path spelling a prefix in the trie. The node's child mask and points are copied in, so scanning the paths
+// reads the trie only where a path continues.
+struct AnnealPath
+{
+    unsigned long long  tiles;          // Bit (tile_index) of every tile on the path
+    int                 node;           // Trie node the path spells
+    unsigned int        child_mask;
+    int                 points;
+    int                 tile_index;     // Last tile of the path
+};
+
+// A pending proposal, see AnnealChain::Propose()
+struct AnnealUndo
+{
+    int                 tile_index;
+    int                 set_index;      // Tile set index before the proposal
+    int                 removed_paths;  // First of the paths it removed in AnnealChain::undo_paths
+    int                 path_sizes;     // First of the path counts per tile before it added any, in AnnealChain::undo_sizes
+};
+
+struct AnnealChain
+{
+    const AnnealTrie*               trie;
+    const BoardGraph*               graph;
+    std::vector<TileCode>           set_codes;  // Decoded WordHunt::GetTileSet()
+    std::vector<TileCode>           codes;
+    std::vector<int>                tile_set;   // Index into WordHunt::GetTileSet() of every tile
+    int                             points;
+    bool                            incremental;
+    std::vector<AnnealUndo>         undo;       // Proposals since Accept(), newest last
+    int                             undo_points;
+    long long                       evaluations;
+
+    // Incremental scoring: every board path spelling a trie prefix is kept, a word scores while its path count is above zero
+    std::vector<std::vector<AnnealPath>> paths;         // Per tile, the paths ending on it
+    std::vector<int>                path_count;         // Per trie node, paths spelling it
+    std::vector<AnnealPath>         undo_paths;         // Paths removed by the pending proposals
+    std::vector<int>                undo_sizes;         // Path count of every tile before each pending proposal added paths
+    std::vector<unsigned long long> neighbor_tiles;     // Per tile, bit of every neighbor
+    std::vector<unsigned int>       neighbor_letters;   // Per tile, first letters of its neighbors
+    unsigned long long              letter_tiles[26];   // Per letter, bit of every active tile starting with it
+
+    // Full rescoring of larger boards, words are deduplicated with a per-node stamp
+    std::vector<unsigned int>       found;      // found[node] == stamp once the word ending at 'node' is counted
+    unsigned int                    stamp;
+    std::vector<char>               visited;
+
+    AnnealChain(const AnnealTrie* _trie, const BoardGraph* _graph)
+    {
+        trie = _trie;
+        graph = _graph;
+        codes = std::vector<TileCode>(graph->TileCount());
+        tile_set = std::vector<int>(graph->TileCount(), 0);
+        points = 0;
+        incremental = graph->TileCount() <= ANNEAL_INCREMENTAL_MAX_TILES;
+        undo_points = 0;
+        evaluations = 0;
+        stamp = 0;
+        memset(letter_tiles, 0, sizeof(letter_tiles));
+
+        if (incremental)
+        {
+            paths = std::vector<std::vector<AnnealPath>>(graph->TileCount());
+            path_count = std::vector<int>(trie->nodes.size(), 0);
+            neighbor_tiles = std::vector<unsigned long long>(graph->TileCount(), 0);
+            neighbor_letters = std::vector<unsigned int>(graph->TileCount(), 0);
+            for (int tile_index = 0; tile_index < graph->TileCount(); tile_index++)
+            {
+                for (int i = graph->offsets[tile_index]; i < graph->offsets[tile_index + 1]; i++)
+                {
+                    neighbor_tiles[tile_index] |= 1ull << graph->neighbors[i];
+                }
+            }
+        }
+        else
+        {
+            found = std::vector<unsigned int>(trie->nodes.size(), 0);
+            visited = std::vector<char>(graph->TileCount(), 0);
+        }
+
+        int set_count;
+        const char* const* tiles = WordHunt::GetTileSet(&set_count);
+        for (int i = 0; i < set_count; i++)
+        {
+            set_codes.push_back(TileCode(tiles[i]));
+        }
+    }
+
+    void CountPath(const AnnealPath& path, int sign)
+    {
+        if (!path.points)
+        {
+            return;
+        }
+        int& count = path_count[path.node];
+        if (sign > 0 ? count++ == 0 : --count == 0)
+        {
+            points += sign * path.points;
+        }
+    }
+
+    // Adds the path 'tiles' continued onto 'tile_index', which spells 'node', and every longer path starting with it.
+    // Only neighbors whose first letter is a child of the node are visited, dead ends cost nothing.
+    void Extend(int tile_index, int node, unsigned long long tiles)
+    {
+        const AnnealNode& n = trie->nodes[node];
+        AnnealPath path;
+        path.tiles = tiles | (1ull << tile_index);
+        path.node = node;
+        path.child_mask = n.child_mask;
+        path.points = n.points;
+        path.tile_index = tile_index;
+        paths[tile_index].push_back(path);
+        CountPath(path, 1);
+
+        for (unsigned int letters = n.child_mask & neighbor_letters[tile_index]; letters; letters &= letters - 1)
+        {
+            for (unsigned long long next = neighbor_tiles[tile_index] & letter_tiles[WordHunt::LowestBit(letters)] & ~path.tiles; next; next &= next - 1)
+            {
+                const int next_index = LowestBit64(next);
+                const int next_node = trie->Advance(node, codes[next_index]);
+                if (next_node >= 0)
+                {
+                    Extend(next_index, next_node, path.tiles);
+                }
+            }
+        }
+    }
+
+    // Drops every path through 'tile_index', keeping them in undo_paths when 'keep_for_undo'. A fifth to a third of the
+    // paths go, so each path is copied to both sides and only the ends move: a branch would mispredict.
+    void RemovePaths(int tile_index, bool keep_for_undo)
+    {
+        const unsigned long long tile_bit = 1ull << tile_index;
+        const size_t first_removed = undo_paths.size();
+        for (std::vector<AnnealPath>& tile_paths : paths)
+        {
+            size_t kept = 0;
+            size_t removed = undo_paths.size();
+            undo_paths.resize(removed + tile_paths.size());
+            for (size_t i = 0; i < tile_paths.size(); i++)
+            {
+                const AnnealPath path = tile_paths[i];
+                const size_t through = (path.tiles & tile_bit) ? 1 : 0;
+                tile_paths[kept] = path;
+                undo_paths[removed] = path;
+                kept += 1 - through;
+                removed += through;
+            }
+            tile_paths.resize(kept);
+            undo_paths.resize(removed);
+        }
+        for (size_t i = first_removed; i < undo_paths.size(); i++)
+        {
+            CountPath(undo_paths[i], -1);
+        }
+        if (!keep_for_undo)
+        {
+            undo_paths.resize(first_removed);
+        }
+    }
+
+    // Adds every path through 'tile_index' once none is left: the paths starting on it, and every kept path ending on a
+    // neighbor continued onto it. 'kept_sizes' holds the path count of every tile before any was added.
+    void AddPaths(int tile_index, const int* kept_sizes)
+    {
+        const unsigned int first_letter = 1u << codes[tile_index].index[0];
+        int node = trie->Advance(0, codes[tile_index]);
+        if (node >= 0)
+        {
+            Extend(tile_index, node, 0);
+        }
+        for (int i = graph->offsets[tile_index]; i < graph->offsets[tile_index + 1]; i++)
+        {
+            const int neighbor_index = graph->neighbors[i];
+            for (int j = 0; j < kept_sizes[neighbor_index]; j++)
+            {
+                const AnnealPath path = paths[neighbor_index][j];
+                if (path.child_mask & first_letter)
+                {
+                    node = trie->Advance(path.node, codes[tile_index]);
+                    if (node >= 0)
+                    {
+                        Extend(tile_index, node, path.tiles);
+                    }
+                }
+            }
+        }
+    }
+
+    void Walk(int tile_index, int node)
+    {
+        const AnnealNode& n = trie->nodes[node];
+        if (n.points && found[node] != stamp)
+        {
+            found[node] = stamp;
+            points += n.points;
+        }
+        if (!n.child_mask)
+        {
+            return;
+        }
+
+        visited[tile_index] = true;
+        for (int i = graph->offsets[tile_index]; i < graph->offsets[tile_index + 1]; i++)
+        {
+            const int next_index = graph->neighbors[i];
+            if (visited[next_index])
+            {
+                continue;
+            }
+            const int next_node = trie->Advance(node, codes[next_index]);
+            if (next_node >= 0)
+            {
+                Walk(next_index, next_node);
+            }
+        }
+        visited[tile_index] = false;
+    }
+
+    // Scores every path on the board
+    void Rescore()
+    {
+        points = 0;
+        if (incremental)
+        {
+            for (std::vector<AnnealPath>& tile_paths : paths)
+            {
+                for (const AnnealPath& path : tile_paths)
+                {
+                    path_count[path.node] = 0;
+                }
+                tile_paths.clear();
+            }
+        }
+        else if (++stamp == 0)
+        {
+            std::fill(found.begin(), found.end(), 0);
+            stamp = 1;
+        }
+        for (int tile_index = 0; tile_index < graph->TileCount(); tile_index++)
+        {
+            const int node = trie->Advance(0, codes[tile_index]);
+            if (!graph->active[tile_index] || node < 0)
+            {
+                continue;
+            }
+            if (incremental)
+            {
+                Extend(tile_index, node, 0);
+            }
+            else
+            {
+                Walk(tile_index, node);
+            }
+        }
+    }
+
+    void SetTile(int tile_index, int set_index)
+    {
+        const unsigned long long tile_bit = 1ull << tile_index;
+        if (incremental && codes[tile_index].length)
+        {
+            letter_tiles[codes[tile_index].index[0]] &= ~tile_bit;
+        }
+        tile_set[tile_index] = set_index;
+        codes[tile_index] = set_codes[set_index];
+        if (!incremental || !graph->active[tile_index])
+        {
+            return;
+        }
+
+        letter_tiles[codes[tile_index].index[0]] |= tile_bit;
+        for (int i = graph->offsets[tile_index]; i < graph->offsets[tile_index + 1]; i++)
+        {
+            const int neighbor_index = graph->neighbors[i];
+            unsigned int letters = 0;
+            for (int j = graph->offsets[neighbor_index]; j < graph->offsets[neighbor_index + 1]; j++)
+            {
+                const TileCode& code = codes[graph->neighbors[j]];
+                letters |= code.length ? 1u << code.index[0] : 0;
+            }
+            neighbor_letters[neighbor_index] = letters;
+        }
+    }
+
+    // Gives 'tile_index' the tile set entry 'set_index' and returns the score change.
+    // Proposals stack until Accept() or Reject(), a swap is two proposals.
+    int Propose(int tile_index, int set_index)
+    {
+        const int before = points;
+        if (undo.empty())
+        {
+            undo_points = points;
+        }
+        AnnealUndo entry;
+        entry.tile_index = tile_index;
+        entry.set_index = tile_set[tile_index];
+        entry.removed_paths = (int)undo_paths.size();
+        entry.path_sizes = (int)undo_sizes.size();
+        undo.push_back(entry);
+        evaluations++;
+
+        if (incremental)
+        {
+            RemovePaths(tile_index, true);
+            SetTile(tile_index, set_index);
+            for (const std::vector<AnnealPath>& tile_paths : paths)
+            {
+                undo_sizes.push_back((int)tile_paths.size());
+            }
+            AddPaths(tile_index, &undo_sizes[entry.path_sizes]);
+        }
+        else
+        {
+            SetTile(tile_index, set_index);
+            Rescore();
+        }
+        return points - before;
+    }
+
+    void Accept()
+    {
+        undo.clear();
+        undo_paths.clear();
+        undo_sizes.clear();
+    }
+
+    // Drops the paths the newest proposal added, they are still the ends of the per-tile lists
+    void DropAddedPaths(const int* kept_sizes)
+    {
+        for (int tile_index = 0; tile_index < graph->TileCount(); tile_index++)
+        {
+            std::vector<AnnealPath>& tile_paths = paths[tile_index];
+            for (size_t i = (size_t)kept_sizes[tile_index]; i < tile_paths.size(); i++)
+            {
+                CountPath(tile_paths[i], -1);
+            }
+            tile_paths.resize(kept_sizes[tile_index]);
+        }
+    }
+
+    // Restores the board before the pending proposals. Unwinding newest first, the paths an older proposal added are
+    // the ones through its tile once the newer proposals are undone.
+    void Reject()
+    {
+        for (bool newest = true; !undo.empty(); newest = false)
+        {
+            const AnnealUndo entry = undo.back();
+            undo.pop_back();
+            if (incremental)
+            {
+                if (newest)
+                {
+                    DropAddedPaths(&undo_sizes[entry.path_sizes]);
+                }
+                else
+                {
+                    RemovePaths(entry.tile_index, false);
+                }
+                for (size_t i = entry.removed_paths; i < undo_paths.size(); i++)
+                {
+                    paths[undo_paths[i].tile_index].push_back(undo_paths[i]);
+                    CountPath(undo_paths[i], 1);
+                }
+                undo_paths.resize(entry.removed_paths);
+                undo_sizes.resize(entry.path_sizes);
+            }
+            SetTile(entry.tile_index, entry.set_index);
+        }
+        points = undo_points;
+    }
+
+    void Randomize(std::mt19937& rng)
+    {
+        for (int tile_index = 0; tile_index < graph->TileCount(); tile_index++)
+        {
+            SetTile(tile_index, std::uniform_int_distribution<int>(0, (int)set_codes.size() - 1)(rng));
+        }
+        Rescore();
+        Accept();
+    }
+};
+
+struct AnnealSettings
+{
+    int             chains;
+    long long       iterations;     // Proposals per chain
+    double          temp_start;
+    double          temp_end;
+    unsigned int    seed_value;
+};
+
+struct AnnealResult
+{
+    int                 points;
+    std::vector<int>    tile_set;
+    long long           evaluations;
+};
+
+static void RunChain(const AnnealTrie* trie, const BoardGraph* graph, const AnnealSettings* settings, int chain_index, AnnealResult* result)
+{
+    std::mt19937 rng(settings->seed_value + 0x9E3779B9u * (unsigned int)chain_index);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::vector<int> active;
+    for (int tile_index = 0; tile_index < graph->TileCount(); tile_index++)
+    {
+        if (graph->active[tile_index])
+        {
+            active.push_back(tile_index);
+        }
+    }
+
+    AnnealChain chain(trie, graph);
+    chain.Randomize(rng);
+    result->points = chain.points;
+    result->tile_set = chain.tile_set;
+    const int set_count = (int)chain.set_codes.size();
+
+    const double cooling = pow(settings->temp_end / settings->temp_start, 1.0 / (double)(settings->iterations > 1 ? settings->iterations - 1 : 1));
+    double temperature = settings->temp_start;
+    for (long long i = 0; i < settings->iterations; i++, temperature *= cooling)
+    {
+        // Either redraw one tile or swap two
+        const int a = active[std::uniform_int_distribution<int>(0, (int)active.size() - 1)(rng)];
+        int delta;
+        if (active.size() > 1 && unit(rng) < 0.3)
+        {
+            const int b = active[std::uniform_int_distribution<int>(0, (int)active.size() - 1)(rng)];
+            const int set_a = chain.tile_set[a], set_b = chain.tile_set[b];
+            if (set_a == set_b)
+            {
+                continue;
+            }
+            delta = chain.Propose(a, set_b);
+            delta += chain.Propose(b, set_a);
+        }
+        else
+        {
+            const int pick = std::uniform_int_distribution<int>(0, set_count - 1)(rng);
+            if (chain.set_codes[pick].length == chain.codes[a].length && memcmp(chain.set_codes[pick].index, chain.codes[a].index, chain.codes[a].length) == 0)
+            {
+                continue;
+            }
+            delta = chain.Propose(a, pick);
+        }
+
+        if (delta >= 0 || unit(rng) < exp(delta / temperature))
+        {
+            chain.Accept();
+            if (chain.points > result->points)
+            {
+                result->points = chain.points;
+                result->tile_set = chain.tile_set;
+            }
+        }
+        else
+        {
+            chain.Reject();
+        }
+    }
+    result->evaluations = chain.evaluations;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] MAIN
+//-------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    AnnealSettings settings;
+    settings.chains = (int)std::thread::hardware_concurrency();
+    settings.chains = settings.chains > 0 ? settings.chains : 1;
+    settings.iterations = 200000;
+    settings.temp_start = 3000.0;
+    settings.temp_end = 50.0;
+    settings.seed_value = (unsigned int)time(NULL);
+
+    int argn = 1;
+    for (; argn < argc && argv[argn][0] == '-'; argn++)
+    {
+        if (strcmp(argv[argn], "-chains") == 0 && argn + 1 < argc)          { settings.chains = atoi(argv[++argn]); }
+        else if (strcmp(argv[argn], "-iters") == 0 && argn + 1 < argc)      { settings.iterations = atoll(argv[++argn]); }
+        else if (strcmp(argv[argn], "-temp") == 0 && argn + 2 < argc)       { settings.temp_start = atof(argv[++argn]); settings.temp_end = atof(argv[++argn]); }
+        else if (strcmp(argv[argn], "-seed") == 0 && argn + 1 < argc)       { settings.seed_value = (unsigned int)strtoul(argv[++argn], NULL, 10); }
+        else
+        {
+            fprintf(stderr, "Unknown argument '%s'\n", argv[argn]);
+            return 1;
+        }
+    }
+    if (argn >= argc || settings.chains < 1 || settings.iterations < 1 || settings.temp_start <= 0.0 || settings.temp_end <= 0.0)
+    {
+        printf("Syntax: %s [-chains N] [-iters N] [-temp T0 T1] [-seed N] <dictionary> [seed]\n", argv[0]);
+        return 0;
+    }
+
+    Seed* seed = new Seed(0u);
+    if (argn + 1 < argc)
+    {
+        if (WordHunt::ParseSeed(argv[argn + 1], NULL) == -1)
+        {
+            fprintf(stderr, "Invalid seed '%s'\n", argv[argn + 1]);
+            return 1;
+        }
+        seed = new Seed(argv[argn + 1]);
+    }
+    if (seed->layout == BoardLayout_Free)
+    {
+        fprintf(stderr, "Free layout boards have no adjacency to optimize\n");
+        return 1;
+    }
+
+    WordHunt::Setup(argv[argn]);
+    AnnealTrie trie;
+    BuildAnnealTrie(&trie, WordHunt::GetDefaultDictionary()->head);
+    BoardGraph graph;
+    WordHunt::BuildBoardGraph(&graph, seed);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<AnnealResult> results(settings.chains);
+    std::vector<std::thread> threads;
+    for (int chain_index = 0; chain_index < settings.chains; chain_index++)
+    {
+        threads.push_back(std::thread(RunChain, &trie, &graph, &settings, chain_index, &results[chain_index]));
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int best = 0;
+    long long evaluations = 0;
+    for (int chain_index = 0; chain_index < settings.chains; chain_index++)
+    {
+        evaluations += results[chain_index].evaluations;
+        best = results[chain_index].points > results[best].points ? chain_index : best;
+        printf("chain %d: %d points\n", chain_index, results[chain_index].points);
+    }
+
+    int set_count;
+    const char* const* tiles = WordHunt::GetTileSet(&set_count);
+    printf("\nbest: %d points (%lld evaluations in %.2f s, %.0f per second per chain)\n", results[best].points, evaluations, seconds, evaluations / seconds / settings.chains);
+    for (int row = 0; row < graph.rows; row++)
+    {
+        for (int col = 0; col < graph.cols; col++)
+        {
+            const int tile_index = row * graph.cols + col;
+            printf("%-3s ", graph.active[tile_index] ? tiles[results[best].tile_set[tile_index]] : ".");
+        }
+        printf("\n");
+    }
+    return 0;
+}
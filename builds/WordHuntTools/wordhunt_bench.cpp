@@ -0,0 +1,276 @@
+// WordHunt tools
+// (wordhunt_bench.cpp)
+// Times the free letters solver on free layout boards and letter racks, and checks its answers while at it.
+
+// Boards are the seed values start .. start + boards - 1 run through WordHunt::GenerateGame() for free layouts of 4x4
+// and 5x5 tiles with 0 .. max_blanks blanks, each solved with WordHunt::SolveCurrentSeed(). A board with one blank must
+// find exactly the words of its 26 boards with the blank replaced by a letter. Square boards with blanks are timed by
+// wordhunt_blanks.cpp.
+// Racks of 16, 20 and 25 letters drawn from WordHunt::GetTileSet() are solved with WordHunt::SolveLetterCounts(), the
+// 25 letter racks with one blank are checked against a plain scan of the dictionary file.
+// Prints the average time per board or rack. Returns 1 when a check fails.
+
+// Build with, e.g:
+//   # cl.exe /O2 /EHsc /I..\WordHunt wordhunt_bench.cpp ..\WordHunt\wordhunt.cpp
+//   # g++ -O2 -std=c++17 -pthread -I../WordHunt wordhunt_bench.cpp ../WordHunt/wordhunt.cpp
+
+// Usage:
+//   wordhunt_bench.exe [-boards N] [-racks N] [-start N] [-max_blanks N] <dictionary>
+// Usage example:
+//   # wordhunt_bench.exe -boards 500 -max_blanks 3 ..\..\misc\files\dictionary.txt
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "wordhunt.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] BOARDS
+//-------------------------------------------------------------------------
+
+static char board_letters[WORDHUNT_MAX_SIDE * WORDHUNT_MAX_SIDE * WORDHUNT_TILE_STRIDE + 1];
+
+static void CollectWords(Solver* solver, std::set<std::string>& words)
+{
+    for (Solution* solution : solver->sol_list)
+    {
+        words.insert(solution->word);
+    }
+}
+
+// Solves the board with its blank replaced by each letter in turn, the blank board must find the union of those words
+static bool CheckBlankBoard(const int tile_count, const std::set<std::string>& found)
+{
+    int blank_index = 0;
+    while (blank_index < tile_count && board_letters[blank_index * WORDHUNT_TILE_STRIDE] != WORDHUNT_BLANK)
+    {
+        blank_index++;
+    }
+    if (blank_index == tile_count)
+    {
+        return false;
+    }
+
+    std::set<std::string> expected;
+    for (char letter = 'A'; letter <= 'Z'; letter++)
+    {
+        board_letters[blank_index * WORDHUNT_TILE_STRIDE] = letter;
+        CollectWords(WordHunt::SolveCurrentSeed(board_letters), expected);
+        WordHunt::GetSessionArena()->Reset();
+    }
+    board_letters[blank_index * WORDHUNT_TILE_STRIDE] = WORDHUNT_BLANK;
+    return found == expected;
+}
+
+// Returns the number of boards that failed their check
+static int BenchBoards(const int side, const int blanks, const unsigned int start, const int boards)
+{
+    Seed seed(0u);
+    seed.SetShape(side, side, true);
+    seed.layout = BoardLayout_Free;
+    seed.blanks = (unsigned char)blanks;
+    WordHunt::SetCurrentSeed(&seed);
+
+    double solve_ms = 0.0;
+    size_t word_count = 0;
+    int failed = 0;
+    for (int board = 0; board < boards; board++)
+    {
+        seed.seed_value = start + (unsigned int)board;
+        WordHunt::GenerateGame(board_letters, side * side, &seed);
+
+        const auto solve_start = std::chrono::steady_clock::now();
+        Solver* solver = WordHunt::SolveCurrentSeed(board_letters);
+        solve_ms += MillisecondsSince(solve_start);
+        word_count += solver->sol_list.size();
+
+        if (blanks == 1)
+        {
+            std::set<std::string> found;
+            CollectWords(solver, found);
+            WordHunt::GetSessionArena()->Reset();
+            if (!CheckBlankBoard(side * side, found))
+            {
+                printf("  Mismatch on seed value %u\n", seed.seed_value);
+                failed++;
+            }
+        }
+        WordHunt::GetSessionArena()->Reset();
+    }
+
+    printf("free   %dx%d blanks %d: %8.1f words/board %8.3f ms/board%s\n", side, side, blanks,
+        (double)word_count / boards, solve_ms / boards, blanks == 1 ? (failed ? "  FAILED" : "  checked") : "");
+    WordHunt::SetCurrentSeed(NULL);
+    return failed;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] LETTER RACKS
+//-------------------------------------------------------------------------
+
+// Counts the dictionary words the rack spells, 'blanks' standing for any letter. Reads the file again on purpose so
+// the check does not share code with the trie walk it checks.
+static size_t ScanDictionary(const char* file_name, const int letter_counts[26], const int blanks)
+{
+    FILE* file = fopen(file_name, "r");
+    if (!file)
+    {
+        return 0;
+    }
+    size_t count = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file))
+    {
+        int length = (int)strcspn(line, "\r\n");
+        if (length < WordHunt::GetMinWordLength())
+        {
+            continue;
+        }
+        int remaining[26];
+        memcpy(remaining, letter_counts, sizeof(remaining));
+        int blanks_left = blanks;
+        bool spelled = true;
+        for (int i = 0; i < length && spelled; i++)
+        {
+            const int letter = line[i] - 'A';
+            if (letter >= 0 && letter < 26 && remaining[letter] > 0)
+            {
+                remaining[letter]--;
+            }
+            else if (letter >= 0 && letter < 26 && blanks_left > 0)
+            {
+                blanks_left--;
+            }
+            else
+            {
+                spelled = false;
+            }
+        }
+        count += spelled ? 1 : 0;
+    }
+    fclose(file);
+    return count;
+}
+
+// Racks hold the letters of tiles drawn from the tile set, the last tile is cut short when it overruns the rack
+static void DrawRack(unsigned long long* random, const int letters, int letter_counts[26])
+{
+    int tile_set_count = 0;
+    const char* const* tile_set = WordHunt::GetTileSet(&tile_set_count);
+    memset(letter_counts, 0, sizeof(int) * 26);
+    for (int drawn = 0; drawn < letters;)
+    {
+        *random = *random * 6364136223846793005ull + 1442695040888963407ull;
+        const char* tile = tile_set[(int)((*random >> 33) % (unsigned long long)tile_set_count)];
+        for (; *tile && drawn < letters; tile++)
+        {
+            if (*tile != WORDHUNT_BLANK)
+            {
+                letter_counts[*tile - 'A']++;
+                drawn++;
+            }
+        }
+    }
+}
+
+// Returns the number of racks that failed their check
+static int BenchRacks(const char* file_name, const int letters, const int blanks, const unsigned int start, const int racks)
+{
+    unsigned long long random = start;
+    double solve_ms = 0.0;
+    size_t word_count = 0;
+    int failed = 0;
+    const bool check = letters == 25 && blanks == 1;
+    for (int rack = 0; rack < racks; rack++)
+    {
+        int letter_counts[26];
+        DrawRack(&random, letters - blanks, letter_counts);
+
+        std::vector<std::string> words;
+        const auto solve_start = std::chrono::steady_clock::now();
+        WordHunt::SolveLetterCounts(WordHunt::GetDefaultDictionary(), letter_counts, blanks, words);
+        solve_ms += MillisecondsSince(solve_start);
+        word_count += words.size();
+
+        if (check && words.size() != ScanDictionary(file_name, letter_counts, blanks))
+        {
+            printf("  Mismatch on rack %d\n", rack);
+            failed++;
+        }
+    }
+
+    printf("rack   %2d letters blanks %d: %8.1f words/rack  %8.3f ms/rack%s\n", letters, blanks,
+        (double)word_count / racks, solve_ms / racks, check ? (failed ? "  FAILED" : "  checked") : "");
+    return failed;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] MAIN
+//-------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    int boards = 200;
+    int racks = 50;
+    unsigned int start = 1;
+    int max_blanks = 3;
+
+    int argn = 1;
+    for (; argn < argc && argv[argn][0] == '-'; argn++)
+    {
+        if (strcmp(argv[argn], "-boards") == 0 && argn + 1 < argc)          { boards = atoi(argv[++argn]); }
+        else if (strcmp(argv[argn], "-racks") == 0 && argn + 1 < argc)      { racks = atoi(argv[++argn]); }
+        else if (strcmp(argv[argn], "-start") == 0 && argn + 1 < argc)      { start = (unsigned int)strtoul(argv[++argn], NULL, 10); }
+        else if (strcmp(argv[argn], "-max_blanks") == 0 && argn + 1 < argc) { max_blanks = atoi(argv[++argn]); }
+        else
+        {
+            fprintf(stderr, "Unknown argument '%s'\n", argv[argn]);
+            return 1;
+        }
+    }
+    if (argn + 1 != argc || boards < 1 || racks < 1 || max_blanks < 0 || max_blanks > 16)
+    {
+        printf("Syntax: %s [-boards N] [-racks N] [-start N] [-max_blanks N] <dictionary>\n", argv[0]);
+        return 0;
+    }
+
+    const auto load_start = std::chrono::steady_clock::now();
+    WordHunt::Setup(argv[argn]);
+    printf("Dictionary loaded in %.0f ms\n", MillisecondsSince(load_start));
+
+    SessionArena session_arena;
+    WordHunt::SetSessionArena(&session_arena);
+
+    int failed = 0;
+    for (int side = 4; side <= 5; side++)
+    {
+        for (int blanks = 0; blanks <= max_blanks; blanks++)
+        {
+            failed += BenchBoards(side, blanks, start, boards);
+        }
+    }
+
+    const int rack_letters[] = { 16, 20, 25 };
+    for (int letters : rack_letters)
+    {
+        for (int blanks = 0; blanks <= 2 && blanks <= max_blanks; blanks++)
+        {
+            failed += BenchRacks(argv[argn], letters, blanks, start, racks);
+        }
+    }
+
+    WordHunt::SetSessionArena(NULL);
+    if (failed)
+    {
+        printf("%d checks failed\n", failed);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+// WordHunt tools
+// (wordhunt_blanks.cpp)
+// Times the solver on square boards with blank tiles, and checks its answers while at it.
+
+// Boards are the seed values start .. start + boards - 1 run through WordHunt::GenerateGame() for 4x4 and 5x5 square
+// boards with 0 .. max_blanks blanks, each solved with WordHunt::SolveCurrentSeed(). A blank only branches over the
+// letters the trie offers, so the time per board should grow by far less than 26x per blank.
+// A board with one blank must find exactly the words of its 26 boards with the blank replaced by a letter.
+// Prints the average time per board. Returns 1 when a check fails.
+
+// Build with, e.g:
+//   # cl.exe /O2 /EHsc /I..\WordHunt wordhunt_blanks.cpp ..\WordHunt\wordhunt.cpp
+//   # g++ -O2 -std=c++17 -pthread -I../WordHunt wordhunt_blanks.cpp ../WordHunt/wordhunt.cpp
+
+// Usage:
+//   wordhunt_blanks.exe [-boards N] [-start N] [-max_blanks N] <dictionary>
+// Usage example:
+//   # wordhunt_blanks.exe -boards 500 -max_blanks 3 ..\..\misc\files\dictionary.txt
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "wordhunt.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] BOARDS
+//-------------------------------------------------------------------------
+
+static char board_letters[WORDHUNT_MAX_SIDE * WORDHUNT_MAX_SIDE * WORDHUNT_TILE_STRIDE + 1];
+
+static void CollectWords(Solver* solver, std::set<std::string>& words)
+{
+    for (Solution* solution : solver->sol_list)
+    {
+        words.insert(solution->word);
+    }
+}
+
+// Solves the board with its blank replaced by each letter in turn, the blank board must find the union of those words
+static bool CheckBlankBoard(const int tile_count, const std::set<std::string>& found)
+{
+    int blank_index = 0;
+    while (blank_index < tile_count && board_letters[blank_index * WORDHUNT_TILE_STRIDE] != WORDHUNT_BLANK)
+    {
+        blank_index++;
+    }
+    if (blank_index == tile_count)
+    {
+        return false;
+    }
+
+    std::set<std::string> expected;
+    for (char letter = 'A'; letter <= 'Z'; letter++)
+    {
+        board_letters[blank_index * WORDHUNT_TILE_STRIDE] = letter;
+        CollectWords(WordHunt::SolveCurrentSeed(board_letters), expected);
+        WordHunt::GetSessionArena()->Reset();
+    }
+    board_letters[blank_index * WORDHUNT_TILE_STRIDE] = WORDHUNT_BLANK;
+    return found == expected;
+}
+
+// Returns the number of boards that failed their check
+static int BenchBoards(const int side, const int blanks, const unsigned int start, const int boards)
+{
+    Seed seed(0u);
+    seed.SetShape(side, side, true);
+    seed.blanks = (unsigned char)blanks;
+    WordHunt::SetCurrentSeed(&seed);
+
+    double solve_ms = 0.0;
+    size_t word_count = 0;
+    int failed = 0;
+    for (int board = 0; board < boards; board++)
+    {
+        seed.seed_value = start + (unsigned int)board;
+        WordHunt::GenerateGame(board_letters, side * side, &seed);
+
+        const auto solve_start = std::chrono::steady_clock::now();
+        Solver* solver = WordHunt::SolveCurrentSeed(board_letters);
+        solve_ms += MillisecondsSince(solve_start);
+        word_count += solver->sol_list.size();
+
+        if (blanks == 1)
+        {
+            std::set<std::string> found;
+            CollectWords(solver, found);
+            WordHunt::GetSessionArena()->Reset();
+            if (!CheckBlankBoard(side * side, found))
+            {
+                printf("  Mismatch on seed value %u\n", seed.seed_value);
+                failed++;
+            }
+        }
+        WordHunt::GetSessionArena()->Reset();
+    }
+
+    printf("square %dx%d blanks %d: %8.1f words/board %8.3f ms/board%s\n", side, side, blanks,
+        (double)word_count / boards, solve_ms / boards, blanks == 1 ? (failed ? "  FAILED" : "  checked") : "");
+    WordHunt::SetCurrentSeed(NULL);
+    return failed;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] MAIN
+//-------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    int boards = 200;
+    unsigned int start = 1;
+    int max_blanks = 3;
+
+    int argn = 1;
+    for (; argn < argc && argv[argn][0] == '-'; argn++)
+    {
+        if (strcmp(argv[argn], "-boards") == 0 && argn + 1 < argc)          { boards = atoi(argv[++argn]); }
+        else if (strcmp(argv[argn], "-start") == 0 && argn + 1 < argc)      { start = (unsigned int)strtoul(argv[++argn], NULL, 10); }
+        else if (strcmp(argv[argn], "-max_blanks") == 0 && argn + 1 < argc) { max_blanks = atoi(argv[++argn]); }
+        else
+        {
+            fprintf(stderr, "Unknown argument '%s'\n", argv[argn]);
+            return 1;
+        }
+    }
+    if (argn + 1 != argc || boards < 1 || max_blanks < 0 || max_blanks > 16)
+    {
+        printf("Syntax: %s [-boards N] [-start N] [-max_blanks N] <dictionary>\n", argv[0]);
+        return 0;
+    }
+
+    const auto load_start = std::chrono::steady_clock::now();
+    WordHunt::Setup(argv[argn]);
+    printf("Dictionary loaded in %.0f ms\n", MillisecondsSince(load_start));
+
+    SessionArena session_arena;
+    WordHunt::SetSessionArena(&session_arena);
+
+    int failed = 0;
+    for (int side = 4; side <= 5; side++)
+    {
+        for (int blanks = 0; blanks <= max_blanks; blanks++)
+        {
+            failed += BenchBoards(side, blanks, start, boards);
+        }
+    }
+
+    WordHunt::SetSessionArena(NULL);
+    if (failed)
+    {
+        printf("%d checks failed\n", failed);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+// WordHunt tools
+// (wordhunt_library.cpp)
+// Mass-produces boards for one seed shape, scores them and writes a puzzle library the game memory maps
+// to serve "daily" and "hard" boards without generating and solving on the spot.
+
+// Boards are the seed values start .. start + count - 1 run through WordHunt::GenerateGame(), scored with
+// WordHunt::ScoreBoard() on every core. Boards with fewer than min_words words are dropped, thirds of the rest
+// by points become the difficulty classes.
+// See PuzzleLibraryHeader in wordhunt.h for the file layout.
+
+// Build with, e.g:
+//   # cl.exe /O2 /EHsc /I..\WordHunt wordhunt_library.cpp ..\WordHunt\wordhunt.cpp
+//   # g++ -O2 -std=c++17 -pthread -I../WordHunt wordhunt_library.cpp ../WordHunt/wordhunt.cpp
+
+// Usage:
+//   wordhunt_library.exe [-count N] [-start N] [-min_words N] <dictionary> <seed> <outputfile>
+// Usage example:
+//   # wordhunt_library.exe -count 100000 ..\..\misc\files\dictionary.txt R4C4>1111111111111111[0]t75v1 ..\..\misc\files\puzzles.whl
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "wordhunt.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+int main(int argc, char** argv)
+{
+    unsigned int count = 10000;
+    unsigned int start = 1;
+    int min_words = 20;
+
+    int argn = 1;
+    for (; argn < argc && argv[argn][0] == '-'; argn++)
+    {
+        if (strcmp(argv[argn], "-count") == 0 && argn + 1 < argc)       { count = (unsigned int)strtoul(argv[++argn], NULL, 10); }
+        else if (strcmp(argv[argn], "-start") == 0 && argn + 1 < argc)  { start = (unsigned int)strtoul(argv[++argn], NULL, 10); }
+        else if (strcmp(argv[argn], "-min_words") == 0 && argn + 1 < argc) { min_words = atoi(argv[++argn]); }
+        else
+        {
+            fprintf(stderr, "Unknown argument '%s'\n", argv[argn]);
+            return 1;
+        }
+    }
+    if (argn + 3 != argc || count == 0)
+    {
+        printf("Syntax: %s [-count N] [-start N] [-min_words N] <dictionary> <seed> <outputfile>\n", argv[0]);
+        return 0;
+    }
+    if (WordHunt::ParseSeed(argv[argn + 1], NULL) == -1)
+    {
+        fprintf(stderr, "Invalid seed '%s'\n", argv[argn + 1]);
+        return 1;
+    }
+
+    WordHunt::Setup(argv[argn]);
+    Seed* shape = new Seed(argv[argn + 1]);
+    const unsigned int tile_count = (unsigned int)(shape->rows * shape->cols);
+
+    PuzzleLibraryHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = WORDHUNT_LIBRARY_MAGIC;
+    header.version = WORDHUNT_LIBRARY_VERSION;
+    header.record_size = (unsigned int)sizeof(PuzzleRecord) + tile_count * WORDHUNT_TILE_STRIDE;
+    header.tile_count = tile_count;
+    header.records_offset = (unsigned int)sizeof(PuzzleLibraryHeader);
+    shape->to_string(header.seed, sizeof(header.seed));
+
+    // Generate and score, each worker takes the next board from a shared counter
+    const auto time_start = std::chrono::steady_clock::now();
+    std::vector<char> records((size_t)count * header.record_size, 0);
+    std::atomic<unsigned int> next_record(0);
+    auto worker = [&]()
+    {
+        Seed seed = *shape;
+        std::vector<char> letters(tile_count * WORDHUNT_TILE_STRIDE + 1);
+        for (unsigned int n = next_record++; n < count; n = next_record++)
+        {
+            seed.seed_value = start + n;
+            WordHunt::GenerateGame(letters.data(), tile_count, &seed);
+            BoardScore score;
+            WordHunt::ScoreBoard(letters.data(), &seed, &score);
+
+            PuzzleRecord* record = (PuzzleRecord*)&records[(size_t)n * header.record_size];
+            record->seed_value = seed.seed_value;
+            record->points = score.points;
+            record->words = (unsigned short)(score.words < 0xFFFF ? score.words : 0xFFFF);
+            record->longest = (unsigned char)score.longest;
+            memcpy(record + 1, letters.data(), tile_count * WORDHUNT_TILE_STRIDE);
+        }
+    };
+    const unsigned int thread_count = std::max(1u, std::min(std::thread::hardware_concurrency(), count));
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < thread_count; i++)
+    {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Drop the boards with too few words
+    auto record_at = [&](unsigned int n) { return (PuzzleRecord*)&records[(size_t)n * header.record_size]; };
+    const unsigned int generated = count;
+    count = 0;
+    for (unsigned int n = 0; n < generated; n++)
+    {
+        if (record_at(n)->words >= min_words)
+        {
+            memmove(record_at(count++), record_at(n), header.record_size);
+        }
+    }
+    if (count == 0)
+    {
+        fprintf(stderr, "No board has %d words or more\n", min_words);
+        return 1;
+    }
+    records.resize((size_t)count * header.record_size);
+    header.record_count = count;
+    header.index_offset = header.records_offset + count * header.record_size;
+
+    // Highest points first, thirds of the kept boards make the difficulty classes
+    std::vector<unsigned int> index(count);
+    for (unsigned int n = 0; n < count; n++)
+    {
+        index[n] = n;
+    }
+    std::sort(index.begin(), index.end(), [&](unsigned int a, unsigned int b)
+    {
+        if (record_at(a)->points != record_at(b)->points)
+        {
+            return record_at(a)->points > record_at(b)->points;
+        }
+        return a < b;
+    });
+    for (int difficulty = 0; difficulty <= PuzzleDifficulty_COUNT; difficulty++)
+    {
+        header.difficulty_start[difficulty] = (unsigned int)((unsigned long long)count * difficulty / PuzzleDifficulty_COUNT);
+    }
+    for (int difficulty = 0; difficulty < PuzzleDifficulty_COUNT; difficulty++)
+    {
+        for (unsigned int i = header.difficulty_start[difficulty]; i < header.difficulty_start[difficulty + 1]; i++)
+        {
+            record_at(index[i])->difficulty = (unsigned char)difficulty;
+        }
+    }
+
+    FILE* out = fopen(argv[argn + 2], "wb");
+    if (!out)
+    {
+        fprintf(stderr, "Cannot open '%s' for writing\n", argv[argn + 2]);
+        return 1;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, out) == 1;
+    written = written && fwrite(records.data(), 1, records.size(), out) == records.size();
+    written = written && fwrite(index.data(), sizeof(unsigned int), index.size(), out) == index.size();
+    written = (fclose(out) == 0) && written;
+    if (!written)
+    {
+        fprintf(stderr, "Error writing '%s'\n", argv[argn + 2]);
+        return 1;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count();
+    printf("%u of %u boards kept in %.2f s, points %d .. %d\n", count, generated, seconds, record_at(index[count - 1])->points, record_at(index[0])->points);
+    for (int difficulty = 0; difficulty < PuzzleDifficulty_COUNT; difficulty++)
+    {
+        const unsigned int first = header.difficulty_start[difficulty], last = header.difficulty_start[difficulty + 1];
+        if (first < last)
+        {
+            printf("  difficulty %d: %u boards, points %d .. %d\n", difficulty, last - first, record_at(index[last - 1])->points, record_at(index[first])->points);
+        }
+    }
+    return 0;
+}
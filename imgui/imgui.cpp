@@ -9829,6 +9829,11 @@ static void ImGui::ErrorCheckNewFrameSanityChecks()
     if (g.IO.ConfigWindowsResizeFromEdges && !(g.IO.BackendFlags & ImGuiBackendFlags_HasMouseCursors))
         g.IO.ConfigWindowsResizeFromEdges = false;
 
+    // Check: text of signed distance field fonts is drawn between ImDrawCallback_SetSignedDistanceField callbacks, which the renderer backend needs to handle.
+    if (!(g.IO.BackendFlags & ImGuiBackendFlags_RendererHasSignedDistanceFields))
+        for (int cfg_n = 0; cfg_n < g.IO.Fonts->ConfigData.Size; cfg_n++)
+            IM_ASSERT(!g.IO.Fonts->ConfigData[cfg_n].SignedDistanceField && "ImFontConfig::SignedDistanceField requires a renderer backend with ImGuiBackendFlags_RendererHasSignedDistanceFields.");
+
     // Perform simple check: error if Docking or Viewport are enabled _exactly_ on frame 1 (instead of frame 0 or later), which is a common error leading to loss of .ini data.
     if (g.FrameCount == 1 && (g.IO.ConfigFlags & ImGuiConfigFlags_DockingEnable) && (g.ConfigFlagsLastFrame & ImGuiConfigFlags_DockingEnable) == 0)
         IM_ASSERT(0 && "Please set DockingEnable before the first call to NewFrame()! Otherwise you will lose your .ini settings!");
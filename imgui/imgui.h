@@ -1618,6 +1618,7 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasSignedDistanceFields = 1 << 4, // Backend Renderer handles ImDrawCallback_SetSignedDistanceField. Required to use fonts built with ImFontConfig::SignedDistanceField.
 
     // [BETA] Viewports
     ImGuiBackendFlags_PlatformHasViewports  = 1 << 10,  // Backend Platform supports multiple viewports.
@@ -2618,6 +2619,12 @@ typedef void (*ImDrawCallback)(const ImDrawList* parent_list, const ImDrawCmd* c
 // It is not done by default because they are many perfectly useful way of altering render state for imgui contents (e.g. changing shader/blending settings before an Image call).
 #define ImDrawCallback_ResetRenderState     (ImDrawCallback)(-1)
 
+// Special Draw callback value emitted around the text of fonts built with ImFontConfig::SignedDistanceField.
+// UserCallbackData != NULL: the following commands sample the font texture as a distance field, resolve the glyph edge (e.g. smoothstep around 0.5 over fwidth()) instead of using the texture alpha as coverage.
+// UserCallbackData == NULL: back to regular rendering. ImDrawCallback_ResetRenderState also goes back to regular rendering.
+// Only emitted when the renderer backend sets ImGuiBackendFlags_RendererHasSignedDistanceFields.
+#define ImDrawCallback_SetSignedDistanceField (ImDrawCallback)(-2)
+
 // Typically, 1 command = 1 GPU draw call (unless command is a callback)
 // - VtxOffset: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset' is enabled,
 //   this fields allow us to render meshes larger than 64K vertices while keeping 16-bit indices.
@@ -2812,6 +2819,7 @@ struct ImDrawList
     IMGUI_API void  AddCallback(ImDrawCallback callback, void* callback_data);  // Your rendering function must check for 'UserCallback' in ImDrawCmd and call the function instead of rendering triangles.
     IMGUI_API void  AddDrawCmd();                                               // This is useful if you need to forcefully create a new draw call (to allow for dependent rendering / blending). Otherwise primitives are merged into the same draw-call as much as possible
     IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer.
+    IMGUI_API void  AddDrawList(const ImDrawList* src, const ImVec2& offset);  // Append the output of another draw list translated by 'offset', e.g. static shapes recorded once instead of tessellated every frame. Drawn with the current clip rect, 'src' must use the current texture.
 
     // Advanced: Channels
     // - Use to split render into layers. By switching channels to can render out-of-order (e.g. submit FG primitives before BG primitives)
@@ -2847,6 +2855,7 @@ struct ImDrawList
     IMGUI_API void  _OnChangedClipRect();
     IMGUI_API void  _OnChangedTextureID();
     IMGUI_API void  _OnChangedVtxOffset();
+    IMGUI_API void  _SetSignedDistanceField(bool enable);
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
     IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
@@ -2897,6 +2906,7 @@ struct ImFontConfig
     bool            MergeMode;              // false    // Merge into previous ImFont, so you can combine multiple inputs font into one ImFont (e.g. ASCII font + icons + Japanese glyphs). You may want to use GlyphOffset.y when merge font of different heights.
     unsigned int    FontBuilderFlags;       // 0        // Settings for custom font builder. THIS IS BUILDER IMPLEMENTATION DEPENDENT. Leave as zero if unsure.
     float           RasterizerMultiply;     // 1.0f     // Brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable.
+    bool            SignedDistanceField;    // false    // Rasterize glyphs as a signed distance field so the font stays sharp when drawn at any size (e.g. one SizePixels=48 font drawn from 16 to 100+ pixels with ImFont::Scale). Ignores OversampleH/V and RasterizerMultiply. Requires ImGuiBackendFlags_RendererHasSignedDistanceFields and the stb_truetype builder. Fonts merged together must all use the same setting.
     ImWchar         EllipsisChar;           // -1       // Explicitly specify unicode codepoint of ellipsis character. When fonts are being merged first specified ellipsis will be used.
 
     // [Internal]
@@ -2981,7 +2991,7 @@ struct ImFontAtlas
     IMGUI_API ImFont*           AddFontDefault(const ImFontConfig* font_cfg = NULL);
     IMGUI_API ImFont*           AddFontFromFileTTF(const char* filename, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);
     IMGUI_API ImFont*           AddFontFromMemoryTTF(void* font_data, int font_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // Note: Transfer ownership of 'ttf_data' to ImFontAtlas! Will be deleted after destruction of the atlas. Set font_cfg->FontDataOwnedByAtlas=false to keep ownership of your data and it won't be freed.
-    IMGUI_API ImFont*           AddFontFromMemoryCompressedTTF(const void* compressed_font_data, int compressed_font_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // 'compressed_font_data' still owned by caller. Compress with binary_to_compressed_c.cpp.
+    IMGUI_API ImFont*           AddFontFromMemoryCompressedTTF(const void* compressed_font_data, int compressed_font_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // 'compressed_font_data' still owned by caller. Compress with binary_to_compressed_c.cpp, with -lz parameter for faster decompression.
     IMGUI_API ImFont*           AddFontFromMemoryCompressedBase85TTF(const char* compressed_font_data_base85, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);              // 'compressed_font_data_base85' still owned by caller. Compress with binary_to_compressed_c.cpp with -base85 parameter.
     IMGUI_API void              ClearInputData();           // Clear input data (all ImFontConfig structures including sizes, TTF data, glyph ranges, etc.) = all the data used to build the texture and fonts.
     IMGUI_API void              ClearTexData();             // Clear output texture data (CPU side). Saves RAM once the texture has been copied to graphics memory.
@@ -2999,6 +3009,14 @@ struct ImFontAtlas
     bool                        IsBuilt() const             { return Fonts.Size > 0 && TexReady; } // Bit ambiguous: used to detect when user didn't build texture but effectively we should check TexID != 0 except that would be backend dependent...
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // Build cache: the built texture, glyphs and font metrics can be written to a file and loaded on a later run instead of rasterizing again.
+    // The file header stores GetBuildInputHash(), a hash of everything Build() reads (font data, sizes, ranges, oversampling, atlas flags...),
+    // so one file name can be reused: a file written for other inputs is rejected and overwritten. Hash once and pass it to both calls.
+    // Atlases with user custom rects (AddCustomRectXXX) are never cached, their contents are drawn by user code after the build.
+    IMGUI_API ImU64             GetBuildInputHash();
+    IMGUI_API bool              LoadBuildCache(const char* filename, ImU64 input_hash);  // Call instead of Build(). Returns false when the file is missing, damaged or was built from other inputs: Build() then.
+    IMGUI_API bool              SaveBuildCache(const char* filename, ImU64 input_hash);  // Call after Build(). Returns false when the atlas is not built or cannot be cached.
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -3046,6 +3064,7 @@ struct ImFontAtlas
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
+    void                        (*ParallelForFn)(void (*func)(void* func_data, int index), void* func_data, int count); // Optional: call func(func_data, 0..count-1), possibly from several threads at once, and return once all calls are done. When set, the stb_truetype builder rasterizes font sources through it.
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
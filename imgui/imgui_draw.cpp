@@ -127,8 +127,22 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// stb_truetype allocates from the rasterization workers when ImFontAtlas::ParallelForFn is set. Its temporary buffers go
+// straight to the allocator functions, as ImGui::MemAlloc()/MemFree() also update the context's allocation counter.
+static void* ImStbTrueTypeAlloc(size_t size)
+{
+    ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* user_data;
+    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data);
+    return alloc_func(size, user_data);
+}
+static void ImStbTrueTypeFree(void* ptr)
+{
+    ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* user_data;
+    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data);
+    free_func(ptr, user_data);
+}
+#define STBTT_malloc(x,u)   ((void)(u), ImStbTrueTypeAlloc(x))
+#define STBTT_free(x,u)     ((void)(u), ImStbTrueTypeFree(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -438,6 +452,40 @@ ImDrawList* ImDrawList::CloneOutput() const
     return dst;
 }
 
+// Vertices are copied in one go, indices command by command as callbacks (e.g. signed distance field text) are replayed in between.
+// The clip rects of 'src' are ignored and its shapes merged into the current command.
+void ImDrawList::AddDrawList(const ImDrawList* src, const ImVec2& offset)
+{
+    const int vtx_count = src->VtxBuffer.Size;
+    PrimReserve(0, vtx_count);
+    const unsigned int vtx_base = _VtxCurrentIdx;
+    IM_ASSERT((sizeof(ImDrawIdx) == 4 || vtx_base + vtx_count <= (1 << 16)) && "Too many vertices in ImDrawList using 16-bit indices.");
+    ImDrawVert* vtx_write = _VtxWritePtr; // Local copies of the write pointers let the loops below vectorize
+    memcpy(vtx_write, src->VtxBuffer.Data, (size_t)vtx_count * sizeof(ImDrawVert));
+    for (int n = 0; n < vtx_count; n++)
+        vtx_write[n].pos += offset;
+    _VtxWritePtr += vtx_count;
+    _VtxCurrentIdx += vtx_count;
+
+    for (const ImDrawCmd& cmd : src->CmdBuffer)
+    {
+        if (cmd.UserCallback == ImDrawCallback_SetSignedDistanceField)
+            _SetSignedDistanceField(cmd.UserCallbackData != NULL);
+        else if (cmd.UserCallback != NULL)
+            AddCallback(cmd.UserCallback, cmd.UserCallbackData);
+        if (cmd.UserCallback != NULL || cmd.ElemCount == 0)
+            continue;
+        IM_ASSERT(cmd.TextureId == _CmdHeader.TextureId);
+        PrimReserve((int)cmd.ElemCount, 0);
+        const ImDrawIdx* src_idx = src->IdxBuffer.Data + cmd.IdxOffset;
+        const ImDrawIdx idx_base = (ImDrawIdx)(vtx_base + cmd.VtxOffset);
+        ImDrawIdx* idx_write = _IdxWritePtr;
+        for (unsigned int n = 0; n < cmd.ElemCount; n++)
+            idx_write[n] = (ImDrawIdx)(src_idx[n] + idx_base);
+        _IdxWritePtr += cmd.ElemCount;
+    }
+}
+
 void ImDrawList::AddDrawCmd()
 {
     ImDrawCmd draw_cmd;
@@ -562,6 +610,25 @@ void ImDrawList::_OnChangedVtxOffset()
     curr_cmd->VtxOffset = _CmdHeader.VtxOffset;
 }
 
+// Called by ImFont around the text of fonts built with ImFontConfig::SignedDistanceField, see ImDrawCallback_SetSignedDistanceField.
+// When the previous text of such a font was closed with nothing drawn since, its command is reopened instead so consecutive texts share one draw call.
+void ImDrawList::_SetSignedDistanceField(bool enable)
+{
+    if (enable && CmdBuffer.Size >= 3)
+    {
+        ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+        ImDrawCmd* end_cmd = curr_cmd - 1;
+        ImDrawCmd* text_cmd = curr_cmd - 2;
+        if (curr_cmd->ElemCount == 0 && end_cmd->UserCallback == ImDrawCallback_SetSignedDistanceField && end_cmd->UserCallbackData == NULL
+            && text_cmd->UserCallback == NULL && ImDrawCmd_HeaderCompare(text_cmd, &_CmdHeader) == 0 && ImDrawCmd_AreSequentialIdxOffset(text_cmd, curr_cmd))
+        {
+            CmdBuffer.shrink(CmdBuffer.Size - 2);
+            return;
+        }
+    }
+    AddCallback(ImDrawCallback_SetSignedDistanceField, enable ? (void*)this : NULL);
+}
+
 int ImDrawList::_CalcCircleAutoSegmentCount(float radius) const
 {
     // Automatic segment count
@@ -2162,6 +2229,9 @@ ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 // Default font TTF is compressed with stb_compress then base85 encoded (see misc/fonts/binary_to_compressed_c.cpp for encoder)
 static unsigned int stb_decompress_length(const unsigned char* input);
 static unsigned int stb_decompress(unsigned char* output, const unsigned char* input, unsigned int length);
+static bool         ImLzIsCompressed(const unsigned char* input, unsigned int input_size);
+static unsigned int ImLzDecompressLength(const unsigned char* input);
+static bool         ImLzDecompress(unsigned char* output, unsigned int output_size, const unsigned char* input, unsigned int input_size);
 static const char*  GetDefaultCompressedFontDataTTFBase85();
 static unsigned int Decode85Byte(char c)                                    { return c >= '\\' ? c-36 : c-35; }
 static void         Decode85(const unsigned char* src, unsigned char* dst)
@@ -2232,11 +2302,26 @@ ImFont* ImFontAtlas::AddFontFromMemoryTTF(void* ttf_data, int ttf_size, float si
     return AddFont(&font_cfg);
 }
 
+// Accepts both stb_compress() data and the faster to decode LZ data written by 'binary_to_compressed_c -lz', told apart by their header.
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
-    const unsigned int buf_decompressed_size = stb_decompress_length((const unsigned char*)compressed_ttf_data);
+    const unsigned char* compressed = (const unsigned char*)compressed_ttf_data;
+    const bool is_lz = ImLzIsCompressed(compressed, (unsigned int)compressed_ttf_size);
+    const unsigned int buf_decompressed_size = is_lz ? ImLzDecompressLength(compressed) : stb_decompress_length(compressed);
     unsigned char* buf_decompressed_data = (unsigned char*)IM_ALLOC(buf_decompressed_size);
-    stb_decompress(buf_decompressed_data, (const unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size);
+    if (is_lz)
+    {
+        if (!ImLzDecompress(buf_decompressed_data, buf_decompressed_size, compressed, (unsigned int)compressed_ttf_size))
+        {
+            IM_FREE(buf_decompressed_data);
+            IM_ASSERT_USER_ERROR(0, "Could not decompress font data!");
+            return NULL;
+        }
+    }
+    else
+    {
+        stb_decompress(buf_decompressed_data, compressed, (unsigned int)compressed_ttf_size);
+    }
 
     ImFontConfig font_cfg = font_cfg_template ? *font_cfg_template : ImFontConfig();
     IM_ASSERT(font_cfg.FontData == NULL);
@@ -2342,6 +2427,242 @@ bool    ImFontAtlas::Build()
     return builder_io->FontBuilder_Build(this);
 }
 
+//-----------------------------------------------------------------------------
+// ImFontAtlas build cache
+//-----------------------------------------------------------------------------
+// File layout: ImFontAtlasCacheHeader, then the position of each custom rect (2 x ImU16), then for each font an
+// ImFontAtlasCacheFont followed by its glyphs, then the TexWidth * TexHeight alpha pixels.
+// Structures are written as laid out in memory: the input hash covers IMGUI_VERSION_NUM and the structure sizes,
+// so a file written by another build or platform never matches and gets rebuilt over.
+//-----------------------------------------------------------------------------
+
+#define IM_FONT_ATLAS_CACHE_VERSION     1
+
+struct ImFontAtlasCacheHeader
+{
+    char        Magic[8];               // "ImFntAC"
+    ImU64       InputHash;
+    int         TexWidth, TexHeight;
+    int         FontsCount;
+    int         CustomRectsCount;
+    int         PackIdMouseCursors, PackIdLines;
+    ImVec2      TexUvScale;
+    ImVec2      TexUvWhitePixel;
+    ImVec4      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+};
+
+struct ImFontAtlasCacheFont
+{
+    float       FontSize;
+    float       Ascent, Descent;
+    int         MetricsTotalSurface;
+    int         GlyphsCount;
+};
+
+static const char FONT_ATLAS_CACHE_MAGIC[8] = "ImFntAC";
+
+// 64-bit multiply-rotate hash over 8 bytes at a time, font files are hashed on every cache lookup
+static ImU64 ImFontAtlasCacheHash(ImU64 hash, const void* data, size_t data_size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (; data_size >= 8; data_size -= 8, bytes += 8)
+    {
+        ImU64 word;
+        memcpy(&word, bytes, 8);
+        hash ^= word * 0x9E3779B97F4A7C15ULL;
+        hash = ((hash << 31) | (hash >> 33)) * 0x100000001B3ULL;
+    }
+    for (; data_size > 0; data_size--, bytes++)
+        hash = (hash ^ *bytes) * 0x100000001B3ULL;
+    return hash ^ (hash >> 29);
+}
+
+// Custom rects added by user code, as opposed to the mouse cursors and baked lines rects registered by ImFontAtlasBuildInit()
+static int ImFontAtlasCacheUserRectsCount(const ImFontAtlas* atlas)
+{
+    return atlas->CustomRects.Size - (atlas->PackIdMouseCursors >= 0 ? 1 : 0) - (atlas->PackIdLines >= 0 ? 1 : 0);
+}
+
+ImU64 ImFontAtlas::GetBuildInputHash()
+{
+    int builder = (FontBuilderIO != NULL) ? 2 : 0;
+#ifdef IMGUI_ENABLE_FREETYPE
+    builder |= 1;
+#endif
+    const int atlas_inputs[] = { IMGUI_VERSION_NUM, IM_FONT_ATLAS_CACHE_VERSION, (int)sizeof(ImWchar), (int)sizeof(ImFontGlyph), (int)sizeof(ImFontAtlasCacheHeader), builder, Flags, TexDesiredWidth, TexGlyphPadding, (int)FontBuilderFlags, Fonts.Size, ConfigData.Size, ImFontAtlasCacheUserRectsCount(this) };
+    ImU64 hash = ImFontAtlasCacheHash(0xCBF29CE484222325ULL, atlas_inputs, sizeof(atlas_inputs));
+    for (int cfg_n = 0; cfg_n < ConfigData.Size; cfg_n++)
+    {
+        const ImFontConfig& cfg = ConfigData[cfg_n];
+        const int cfg_ints[] = { cfg.FontDataSize, cfg.FontNo, cfg.OversampleH, cfg.OversampleV, cfg.PixelSnapH, cfg.MergeMode, (int)cfg.FontBuilderFlags, (int)cfg.EllipsisChar, cfg.SignedDistanceField, (int)(Fonts.find(cfg.DstFont) - Fonts.begin()) };
+        const float cfg_floats[] = { cfg.SizePixels, cfg.GlyphExtraSpacing.x, cfg.GlyphExtraSpacing.y, cfg.GlyphOffset.x, cfg.GlyphOffset.y, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX, cfg.RasterizerMultiply };
+        hash = ImFontAtlasCacheHash(hash, cfg_ints, sizeof(cfg_ints));
+        hash = ImFontAtlasCacheHash(hash, cfg_floats, sizeof(cfg_floats));
+        if (cfg.FontData)
+            hash = ImFontAtlasCacheHash(hash, cfg.FontData, (size_t)cfg.FontDataSize);
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : GetGlyphRangesDefault();
+        const ImWchar* ranges_end = ranges;
+        while (ranges_end[0])
+            ranges_end++;
+        hash = ImFontAtlasCacheHash(hash, ranges, (size_t)(ranges_end - ranges) * sizeof(ImWchar));
+    }
+    return hash;
+}
+
+bool    ImFontAtlas::LoadBuildCache(const char* filename, ImU64 input_hash)
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    if (ConfigData.Size == 0 || ImFontAtlasCacheUserRectsCount(this) != 0)
+        return false;
+    for (int cfg_n = 0; cfg_n < ConfigData.Size; cfg_n++)
+        if (ConfigData[cfg_n].FontData == NULL)
+            return false;
+
+    size_t file_size = 0;
+    unsigned char* file_data = (unsigned char*)ImFileLoadToMemory(filename, "rb", &file_size, 0);
+    if (file_data == NULL)
+        return false;
+
+    // Walk and validate the whole file before touching the atlas
+    bool valid = file_size >= sizeof(ImFontAtlasCacheHeader);
+    ImFontAtlasCacheHeader header;
+    if (valid)
+    {
+        memcpy(&header, file_data, sizeof(header));
+        valid = memcmp(header.Magic, FONT_ATLAS_CACHE_MAGIC, sizeof(header.Magic)) == 0 && header.InputHash == input_hash;
+        valid = valid && header.FontsCount == Fonts.Size && header.CustomRectsCount >= 0 && header.CustomRectsCount <= 2 && header.TexWidth > 0 && header.TexHeight > 0;
+    }
+    size_t offset = sizeof(ImFontAtlasCacheHeader);
+    const size_t rects_offset = offset;
+    offset += (size_t)(valid ? header.CustomRectsCount : 0) * sizeof(ImU16) * 2;
+    const size_t fonts_offset = offset;
+    for (int font_n = 0; valid && font_n < header.FontsCount; font_n++)
+    {
+        ImFontAtlasCacheFont font_header;
+        valid = offset + sizeof(font_header) <= file_size;
+        if (!valid)
+            break;
+        memcpy(&font_header, file_data + offset, sizeof(font_header));
+        valid = font_header.GlyphsCount >= 0;
+        offset += sizeof(font_header) + (size_t)font_header.GlyphsCount * sizeof(ImFontGlyph);
+    }
+    const size_t pixels_offset = offset;
+    valid = valid && file_size == pixels_offset + (size_t)header.TexWidth * (size_t)header.TexHeight;
+    if (!valid)
+    {
+        IM_FREE(file_data);
+        return false;
+    }
+
+    // Custom rects are registered as Build() would, only their packed positions come from the file
+    ImFontAtlasBuildInit(this);
+    if (CustomRects.Size != header.CustomRectsCount || PackIdMouseCursors != header.PackIdMouseCursors || PackIdLines != header.PackIdLines)
+    {
+        IM_FREE(file_data);
+        return false;
+    }
+    for (int rect_n = 0; rect_n < CustomRects.Size; rect_n++)
+    {
+        ImU16 rect_pos[2];
+        memcpy(rect_pos, file_data + rects_offset + rect_n * sizeof(rect_pos), sizeof(rect_pos));
+        CustomRects[rect_n].X = rect_pos[0];
+        CustomRects[rect_n].Y = rect_pos[1];
+    }
+
+    ClearTexData();
+    TexWidth = header.TexWidth;
+    TexHeight = header.TexHeight;
+    TexUvScale = header.TexUvScale;
+    TexUvWhitePixel = header.TexUvWhitePixel;
+    memcpy(TexUvLines, header.TexUvLines, sizeof(TexUvLines));
+    TexPixelsAlpha8 = (unsigned char*)IM_ALLOC((size_t)TexWidth * (size_t)TexHeight);
+    memcpy(TexPixelsAlpha8, file_data + pixels_offset, (size_t)TexWidth * (size_t)TexHeight);
+
+    // Same font setup as ImFontAtlasBuildSetupFont(), then the glyphs of the earlier build
+    offset = fonts_offset;
+    for (int font_n = 0; font_n < Fonts.Size; font_n++)
+    {
+        ImFont* font = Fonts[font_n];
+        ImFontAtlasCacheFont font_header;
+        memcpy(&font_header, file_data + offset, sizeof(font_header));
+        offset += sizeof(font_header);
+
+        font->ClearOutputData();
+        font->FontSize = font_header.FontSize;
+        font->ConfigData = NULL;
+        font->ConfigDataCount = 0;
+        for (int cfg_n = 0; cfg_n < ConfigData.Size; cfg_n++)
+            if (ConfigData[cfg_n].DstFont == font)
+            {
+                if (font->ConfigData == NULL)
+                    font->ConfigData = &ConfigData[cfg_n];
+                font->ConfigDataCount++;
+            }
+        font->ContainerAtlas = this;
+        font->Ascent = font_header.Ascent;
+        font->Descent = font_header.Descent;
+        font->MetricsTotalSurface = font_header.MetricsTotalSurface;
+        font->Glyphs.resize(font_header.GlyphsCount);
+        if (font_header.GlyphsCount > 0)
+            memcpy(font->Glyphs.Data, file_data + offset, (size_t)font_header.GlyphsCount * sizeof(ImFontGlyph));
+        offset += (size_t)font_header.GlyphsCount * sizeof(ImFontGlyph);
+        font->BuildLookupTable();
+    }
+    IM_FREE(file_data);
+    TexReady = true;
+    return true;
+}
+
+bool    ImFontAtlas::SaveBuildCache(const char* filename, ImU64 input_hash)
+{
+    if (!TexReady || TexPixelsAlpha8 == NULL || TexPixelsUseColors || ImFontAtlasCacheUserRectsCount(this) != 0)
+        return false;
+    for (int cfg_n = 0; cfg_n < ConfigData.Size; cfg_n++)
+        if (ConfigData[cfg_n].FontData == NULL)
+            return false;
+
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, FONT_ATLAS_CACHE_MAGIC, sizeof(header.Magic));
+    header.InputHash = input_hash;
+    header.TexWidth = TexWidth;
+    header.TexHeight = TexHeight;
+    header.FontsCount = Fonts.Size;
+    header.CustomRectsCount = CustomRects.Size;
+    header.PackIdMouseCursors = PackIdMouseCursors;
+    header.PackIdLines = PackIdLines;
+    header.TexUvScale = TexUvScale;
+    header.TexUvWhitePixel = TexUvWhitePixel;
+    memcpy(header.TexUvLines, TexUvLines, sizeof(header.TexUvLines));
+
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+    bool written = ImFileWrite(&header, sizeof(header), 1, f) == 1;
+    for (int rect_n = 0; written && rect_n < CustomRects.Size; rect_n++)
+    {
+        const ImU16 rect_pos[2] = { CustomRects[rect_n].X, CustomRects[rect_n].Y };
+        written = ImFileWrite(rect_pos, sizeof(rect_pos), 1, f) == 1;
+    }
+    for (int font_n = 0; written && font_n < Fonts.Size; font_n++)
+    {
+        const ImFont* font = Fonts[font_n];
+        ImFontAtlasCacheFont font_header;
+        font_header.FontSize = font->FontSize;
+        font_header.Ascent = font->Ascent;
+        font_header.Descent = font->Descent;
+        font_header.MetricsTotalSurface = font->MetricsTotalSurface;
+        font_header.GlyphsCount = font->Glyphs.Size;
+        written = ImFileWrite(&font_header, sizeof(font_header), 1, f) == 1;
+        if (written && font->Glyphs.Size > 0)
+            written = ImFileWrite(font->Glyphs.Data, sizeof(ImFontGlyph), (ImU64)font->Glyphs.Size, f) == (ImU64)font->Glyphs.Size;
+    }
+    if (written)
+        written = ImFileWrite(TexPixelsAlpha8, 1, (ImU64)TexWidth * TexHeight, f) == (ImU64)TexWidth * TexHeight;
+    written = ImFileClose(f) && written;
+    return written;
+}
+
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
 {
     for (unsigned int i = 0; i < 256; i++)
@@ -2386,6 +2707,24 @@ struct ImFontBuildDstData
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// One rasterization task per source font with glyphs
+struct ImFontBuildRasterizeTask
+{
+    int                         Surface;    // Packed surface of the source's glyphs, larger tasks are started first
+    int                         SrcIndex;
+    int                         ScratchOffset;  // Into ImFontBuildRasterizeData::Scratch, for ImFontConfig::SignedDistanceField sources
+};
+
+// Shared by the rasterization tasks, see ImFontAtlasBuildRasterizeSource()
+struct ImFontBuildRasterizeData
+{
+    ImFontAtlas*                Atlas;
+    ImFontBuildSrcData*         SrcTmp;
+    const stbtt_pack_context*   PackContext;
+    ImVector<ImFontBuildRasterizeTask> Tasks;
+    ImVector<unsigned char>     Scratch;        // Allocated up front, ImGui::MemAlloc() is not meant to be called from the rasterization threads
+};
+
 static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -2398,6 +2737,179 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+static int IMGUI_CDECL ImFontBuildRasterizeTaskComparer(const void* lhs, const void* rhs)
+{
+    const ImFontBuildRasterizeTask* a = (const ImFontBuildRasterizeTask*)lhs;
+    const ImFontBuildRasterizeTask* b = (const ImFontBuildRasterizeTask*)rhs;
+    if (a->Surface != b->Surface)
+        return (a->Surface > b->Surface) ? -1 : +1;
+    return (a->SrcIndex < b->SrcIndex) ? -1 : +1;
+}
+
+// Distance field glyphs (ImFontConfig::SignedDistanceField) extend FONT_ATLAS_SDF_PADDING pixels past the outline, mapped to 0..255 with the outline at 128
+#define FONT_ATLAS_SDF_PADDING  4
+#define FONT_ATLAS_SDF_ONEDGE   128
+
+static float ImFontAtlasBuildGetSourceScale(const ImFontBuildSrcData& src_tmp, const ImFontConfig& cfg)
+{
+    return (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
+}
+
+// Squared distance transform of one row or column of a grid (Felzenszwalb & Huttenlocher): grid[q] = min over r of (q - r)^2 + grid[r]
+static void ImFontAtlasBuildDistanceTransform1D(float* grid, int offset, int stride, int length, float* f, float* z, int* v)
+{
+    v[0] = 0;
+    z[0] = -FLT_MAX;
+    z[1] = +FLT_MAX;
+    f[0] = grid[offset];
+    for (int q = 1, k = 0; q < length; q++)
+    {
+        f[q] = grid[offset + q * stride];
+        float s;
+        do
+        {
+            const int r = v[k];
+            s = (f[q] - f[r] + (float)(q * q - r * r)) / (float)(q - r) * 0.5f;
+        } while (s <= z[k] && --k > -1);
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = +FLT_MAX;
+    }
+    for (int q = 0, k = 0; q < length; q++)
+    {
+        while (z[k + 1] < q)
+            k++;
+        const int r = v[k];
+        grid[offset + q * stride] = f[r] + (float)((q - r) * (q - r));
+    }
+}
+
+// Largest distance field bitmap of a source, the packed rects hold it plus TexGlyphPadding
+static void ImFontAtlasBuildGetSignedDistanceFieldMaxSize(const ImFontAtlas* atlas, const ImFontBuildSrcData& src_tmp, int* out_w, int* out_h)
+{
+    *out_w = *out_h = 0;
+    for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
+    {
+        *out_w = ImMax(*out_w, src_tmp.Rects[glyph_i].w - atlas->TexGlyphPadding);
+        *out_h = ImMax(*out_h, src_tmp.Rects[glyph_i].h - atlas->TexGlyphPadding);
+    }
+}
+
+static int ImFontAtlasBuildCalcSignedDistanceFieldScratchSize(int w, int h)
+{
+    const int n = ImMax(w, h);
+    return (int)sizeof(float) * (w * h * 2 + n * 2 + 1) + (int)sizeof(int) * n + w * h;
+}
+
+// Same output as stbtt_PackFontRangesRenderIntoRects() (pixels in the packed rects and their stbtt_packedchar), with a distance field per glyph.
+// Each glyph is rasterized at its size then turned into distances to the outline: partially covered pixels are about (0.5 - coverage) from it,
+// the distance transform spreads that to FONT_ATLAS_SDF_PADDING pixels. This is a few ms per font, where stbtt_GetGlyphSDF() takes ~100 ms.
+static void ImFontAtlasBuildRenderSignedDistanceFields(ImFontAtlas* atlas, ImFontBuildSrcData& src_tmp, const ImFontConfig& cfg, unsigned char* scratch)
+{
+    const float INF = 1e20f;
+    const int sdf_padding = FONT_ATLAS_SDF_PADDING;
+    const float scale = ImFontAtlasBuildGetSourceScale(src_tmp, cfg);
+    const int padding = atlas->TexGlyphPadding;
+    int max_w, max_h;
+    ImFontAtlasBuildGetSignedDistanceFieldMaxSize(atlas, src_tmp, &max_w, &max_h);
+    const int max_n = ImMax(max_w, max_h);
+    float* grid_outer = (float*)(void*)scratch;
+    float* grid_inner = grid_outer + max_w * max_h;
+    float* f = grid_inner + max_w * max_h;
+    float* z = f + max_n;
+    int* v = (int*)(void*)(z + max_n + 1);
+    unsigned char* coverage = (unsigned char*)(v + max_n);
+
+    for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
+    {
+        const stbrp_rect& r = src_tmp.Rects[glyph_i];
+        if (!r.was_packed)
+            continue;
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
+        int advance, lsb, x0, y0, x1, y1;
+        stbtt_GetGlyphHMetrics(&src_tmp.FontInfo, glyph_index_in_font, &advance, &lsb);
+        stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale, scale, 0, 0, &x0, &y0, &x1, &y1);
+        int w = 0, h = 0;
+        if (x0 != x1 && y0 != y1)
+        {
+            w = x1 - x0 + sdf_padding * 2;
+            h = y1 - y0 + sdf_padding * 2;
+            x0 -= sdf_padding;
+            y0 -= sdf_padding;
+            IM_ASSERT(w + padding <= r.w && h + padding <= r.h);
+            memset(coverage, 0, (size_t)(w * h));
+            stbtt_MakeGlyphBitmapSubpixel(&src_tmp.FontInfo, coverage + sdf_padding * w + sdf_padding, w - sdf_padding * 2, h - sdf_padding * 2, w, scale, scale, 0.0f, 0.0f, glyph_index_in_font);
+            for (int i = 0; i < w * h; i++)
+            {
+                const float d = 0.5f - coverage[i] / 255.0f;
+                grid_outer[i] = (coverage[i] == 255) ? 0.0f : (coverage[i] == 0) ? INF : (d > 0.0f) ? d * d : 0.0f;
+                grid_inner[i] = (coverage[i] == 255) ? INF : (coverage[i] == 0) ? 0.0f : (d < 0.0f) ? d * d : 0.0f;
+            }
+            for (int x = 0; x < w; x++)
+            {
+                ImFontAtlasBuildDistanceTransform1D(grid_outer, x, w, h, f, z, v);
+                ImFontAtlasBuildDistanceTransform1D(grid_inner, x, w, h, f, z, v);
+            }
+            for (int y = 0; y < h; y++)
+            {
+                ImFontAtlasBuildDistanceTransform1D(grid_outer, y * w, 1, w, f, z, v);
+                ImFontAtlasBuildDistanceTransform1D(grid_inner, y * w, 1, w, f, z, v);
+            }
+            for (int y = 0; y < h; y++)
+            {
+                unsigned char* out = atlas->TexPixelsAlpha8 + (r.y + padding + y) * atlas->TexWidth + r.x + padding;
+                for (int x = 0; x < w; x++)
+                {
+                    const float distance = ImSqrt(grid_inner[y * w + x]) - ImSqrt(grid_outer[y * w + x]); // Positive inside
+                    const float value = FONT_ATLAS_SDF_ONEDGE + distance * ((float)FONT_ATLAS_SDF_ONEDGE / sdf_padding);
+                    out[x] = (unsigned char)ImClamp(value + 0.5f, 0.0f, 255.0f);
+                }
+            }
+        }
+        stbtt_packedchar& pc = src_tmp.PackedChars[glyph_i];
+        pc.x0 = (unsigned short)(r.x + padding);
+        pc.y0 = (unsigned short)(r.y + padding);
+        pc.x1 = (unsigned short)(r.x + padding + w);
+        pc.y1 = (unsigned short)(r.y + padding + h);
+        pc.xoff = (float)x0;
+        pc.yoff = (float)y0;
+        pc.xoff2 = (float)(x0 + w);
+        pc.yoff2 = (float)(y0 + h);
+        pc.xadvance = scale * advance;
+    }
+}
+
+// Rasterize the glyphs of one source font into its packed rects. May run on any thread when ImFontAtlas::ParallelForFn is set.
+static void ImFontAtlasBuildRasterizeSource(void* func_data, int task_n)
+{
+    ImFontBuildRasterizeData* data = (ImFontBuildRasterizeData*)func_data;
+    ImFontAtlas* atlas = data->Atlas;
+    const int src_i = data->Tasks[task_n].SrcIndex;
+    ImFontBuildSrcData& src_tmp = data->SrcTmp[src_i];
+    const ImFontConfig& cfg = atlas->ConfigData[src_i];
+    if (cfg.SignedDistanceField)
+    {
+        ImFontAtlasBuildRenderSignedDistanceFields(atlas, src_tmp, cfg, data->Scratch.Data + data->Tasks[task_n].ScratchOffset);
+        return;
+    }
+
+    // stbtt_PackFontRangesRenderIntoRects() writes the range's oversampling into the context while it renders, each task uses its own copy
+    stbtt_pack_context spc = *data->PackContext;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = &src_tmp.Rects[0];
+        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+    }
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2531,16 +3043,27 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.PackRange.v_oversample = (unsigned char)cfg.OversampleV;
 
         // Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
-        const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
+        const float scale = ImFontAtlasBuildGetSourceScale(src_tmp, cfg);
         const int padding = atlas->TexGlyphPadding;
         for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
         {
             int x0, y0, x1, y1;
             const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
             IM_ASSERT(glyph_index_in_font != 0);
-            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+            if (cfg.SignedDistanceField)
+            {
+                // Empty glyphs have no distance field either
+                stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale, scale, 0, 0, &x0, &y0, &x1, &y1);
+                const int sdf_padding = (x0 == x1 || y0 == y1) ? 0 : FONT_ATLAS_SDF_PADDING;
+                src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + sdf_padding * 2);
+                src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + sdf_padding * 2);
+            }
+            else
+            {
+                stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+                src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+                src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+            }
             total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
         }
     }
@@ -2587,27 +3110,44 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Every source writes only inside its own packed rects, so sources may be rasterized in any order or at the same time.
+    ImFontBuildRasterizeData rasterize_data;
+    rasterize_data.Atlas = atlas;
+    rasterize_data.SrcTmp = src_tmp_array.Data;
+    rasterize_data.PackContext = &spc;
+    int scratch_size = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        ImFontBuildRasterizeTask task;
+        task.Surface = 0;
+        task.SrcIndex = src_i;
+        task.ScratchOffset = scratch_size;
+        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
+            task.Surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+        if (atlas->ConfigData[src_i].SignedDistanceField)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            int max_w, max_h;
+            ImFontAtlasBuildGetSignedDistanceFieldMaxSize(atlas, src_tmp, &max_w, &max_h);
+            scratch_size += (ImFontAtlasBuildCalcSignedDistanceFieldScratchSize(max_w, max_h) + 15) & ~15;
         }
-        src_tmp.Rects = NULL;
+        rasterize_data.Tasks.push_back(task);
+    }
+    rasterize_data.Scratch.resize(scratch_size);
+    if (atlas->ParallelForFn && rasterize_data.Tasks.Size > 1)
+    {
+        ImQsort(rasterize_data.Tasks.Data, (size_t)rasterize_data.Tasks.Size, sizeof(ImFontBuildRasterizeTask), ImFontBuildRasterizeTaskComparer);
+        atlas->ParallelForFn(ImFontAtlasBuildRasterizeSource, &rasterize_data, rasterize_data.Tasks.Size);
     }
+    else
+    {
+        for (int task_n = 0; task_n < rasterize_data.Tasks.Size; task_n++)
+            ImFontAtlasBuildRasterizeSource(&rasterize_data, task_n);
+    }
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -2630,6 +3170,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         const float ascent = ImFloor(unscaled_ascent * font_scale + ((unscaled_ascent > 0.0f) ? +1 : -1));
         const float descent = ImFloor(unscaled_descent * font_scale + ((unscaled_descent > 0.0f) ? +1 : -1));
         ImFontAtlasBuildSetupFont(atlas, dst_font, &cfg, ascent, descent);
+        IM_ASSERT(cfg.SignedDistanceField == dst_font->ConfigData->SignedDistanceField && "Fonts merged together must all use the same SignedDistanceField setting.");
         const float font_off_x = cfg.GlyphOffset.x;
         const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(dst_font->Ascent);
 
@@ -3614,8 +4155,13 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     float scale = (size >= 0.0f) ? (size / FontSize) : 1.0f;
     float x = IM_FLOOR(pos.x);
     float y = IM_FLOOR(pos.y);
+    const bool signed_distance_field = ConfigData && ConfigData->SignedDistanceField;
+    if (signed_distance_field)
+        draw_list->_SetSignedDistanceField(true);
     draw_list->PrimReserve(6, 4);
     draw_list->PrimRectUV(ImVec2(x + glyph->X0 * scale, y + glyph->Y0 * scale), ImVec2(x + glyph->X1 * scale, y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
+    if (signed_distance_field)
+        draw_list->_SetSignedDistanceField(false);
 }
 
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
@@ -3673,6 +4219,11 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     if (s == text_end)
         return;
 
+    // Distance field glyphs are resolved by the renderer between two ImDrawCallback_SetSignedDistanceField callbacks
+    const bool signed_distance_field = ConfigData && ConfigData->SignedDistanceField;
+    if (signed_distance_field)
+        draw_list->_SetSignedDistanceField(true);
+
     // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
     const int vtx_count_max = (int)(text_end - s) * 4;
     const int idx_count_max = (int)(text_end - s) * 6;
@@ -3801,6 +4352,8 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
     draw_list->_VtxCurrentIdx = vtx_index;
+    if (signed_distance_field)
+        draw_list->_SetSignedDistanceField(false);
 }
 
 //-----------------------------------------------------------------------------
@@ -4034,6 +4587,7 @@ void ImGui::RenderColorRectWithAlphaCheckerboard(ImDrawList* draw_list, ImVec2 p
 // [SECTION] Decompression code
 //-----------------------------------------------------------------------------
 // Compressed with stb_compress() then converted to a C array and encoded as base85.
+// Data compressed with 'binary_to_compressed_c -lz' uses a simpler byte-aligned LZ format (see ImLzDecompress) instead.
 // Use the program in misc/fonts/binary_to_compressed_c.cpp to create the array from a TTF file.
 // The purpose of encoding as base85 instead of "0x00,0x01,..." style is only save on _source code_ size.
 // Decompression from stb.h (public domain) by Sean Barrett https://github.com/nothings/stb/blob/master/stb.h
@@ -4149,6 +4703,98 @@ static unsigned int stb_decompress(unsigned char *output, const unsigned char *i
     }
 }
 
+// Byte-aligned LZ format written by 'binary_to_compressed_c -lz', trading some size against stb_compress() for a decoder
+// that spends its time in memcpy() instead of branching on every opcode.
+// - Header: "IMLZ" followed by the decompressed size (32-bit little-endian).
+// - Sequences of: token byte (literal count in high 4 bits, match length - 4 in low 4 bits), literal count extension,
+//   literals, match offset (16-bit little-endian, 1..65535), match length extension.
+// - A count of 15 in the token is continued by extension bytes added to it, up to and including the first byte below 255.
+// - The last sequence stops after its literals, when the decompressed size is reached.
+// Padding after the end of the stream (e.g. from base85 encoding) is ignored. Malformed data is reported, never overrun.
+#define IMLZ_HEADER_SIZE    8
+#define IMLZ_MIN_MATCH      4
+
+static bool ImLzIsCompressed(const unsigned char* input, unsigned int input_size)
+{
+    return input_size >= IMLZ_HEADER_SIZE && input[0] == 'I' && input[1] == 'M' && input[2] == 'L' && input[3] == 'Z';
+}
+
+static unsigned int ImLzDecompressLength(const unsigned char* input)
+{
+    return input[4] | (input[5] << 8) | (input[6] << 16) | ((unsigned int)input[7] << 24);
+}
+
+static bool ImLzDecompress(unsigned char* output, unsigned int output_size, const unsigned char* input, unsigned int input_size)
+{
+    const unsigned char* ip = input + IMLZ_HEADER_SIZE;
+    const unsigned char* ip_end = input + input_size;
+    unsigned char* op = output;
+    unsigned char* op_end = output + output_size;
+    while (op < op_end)
+    {
+        if (ip >= ip_end)
+            return false;
+        const unsigned int token = *ip++;
+
+        // Literals
+        size_t count = token >> 4;
+        if (count == 15)
+            for (unsigned int b = 255; b == 255; count += b)
+            {
+                if (ip >= ip_end)
+                    return false;
+                b = *ip++;
+            }
+        if (count > (size_t)(ip_end - ip) || count > (size_t)(op_end - op))
+            return false;
+        if (count <= 16 && ip_end - ip >= 16 && op_end - op >= 16)
+            memcpy(op, ip, 16); // Fixed size copy of short runs, the bytes written past the literals are overwritten by the following sequences
+        else
+            memcpy(op, ip, count);
+        op += count;
+        ip += count;
+        if (op == op_end)
+            break;
+
+        // Match
+        if (ip_end - ip < 2)
+            return false;
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        count = (token & 15) + IMLZ_MIN_MATCH;
+        if (count == 15 + IMLZ_MIN_MATCH)
+            for (unsigned int b = 255; b == 255; count += b)
+            {
+                if (ip >= ip_end)
+                    return false;
+                b = *ip++;
+            }
+        if (offset == 0 || offset > (size_t)(op - output) || count > (size_t)(op_end - op))
+            return false;
+        const unsigned char* match = op - offset;
+        unsigned char* match_end = op + count;
+        if (offset >= 8 && (size_t)(op_end - op) >= count + 8)
+        {
+            // 8 bytes at a time, may write up to 7 bytes past 'match_end'
+            for (; op < match_end; op += 8, match += 8)
+                memcpy(op, match, 8);
+            op = match_end;
+        }
+        else if (offset >= count)
+        {
+            memcpy(op, match, count);
+            op += count;
+        }
+        else
+        {
+            // Overlapping copy repeats the last 'offset' bytes
+            while (op < match_end)
+                *op++ = *match++;
+        }
+    }
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Default font data (ProggyClean.ttf)
 //-----------------------------------------------------------------------------